@@ -0,0 +1,11 @@
+# Консольные замеры производительности физики (без окна, только QtCore)
+QT = core
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = physicsbench
+
+include(../core/core.pri)
+
+SOURCES += \
+    physicsbench.cpp
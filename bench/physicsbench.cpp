@@ -0,0 +1,499 @@
+// Масштабируемость шага физики: от 16 до 4096 шашек.
+// Доска растёт вместе с числом шашек (boardCells клеток, boardCells/4 рядов
+// на сторону), так что плотность расстановки одинакова на всех размерах.
+// При линейной стоимости broadphase время на шашку почти не меняется.
+//
+// physicsbench --validate: серия случайных ударов на стандартной доске
+// разыгрывается пошаговым (с шагом игры, вдвое мельче и вдвое крупнее) и
+// аналитическим (событийным) движками, выводятся расхождения конечных позиций
+// и время на удар. Код возврата 1, если среднее или худшее расхождение больше
+// допуска или хоть одна шашка выбыла только в одном из движков.
+//
+// physicsbench --batch: пропускная способность ShotBatch (кандидатов в секунду)
+// на стандартной доске для пулов от 1 потока до числа ядер.
+//
+// physicsbench --search: качество поиска удара. В случайных позициях лучший
+// удар по evaluateMove ищется плотным перебором (эталон), прежней
+// фиксированной сеткой и адаптивным searchShot с разными бюджетами; выводятся
+// среднее отставание от эталона и доля позиций, где найден почти лучший удар.
+//
+// physicsbench --selfplay [партий] [потоков] [множитель бюджета]: бот Master
+// (MCTS) против Hard на стандартной доске, оба через BotPlayer, как в игре
+// (без дебютной книги). Бюджет Master на ход равен бюджету Hard, умноженному
+// на множитель (по умолчанию 1), цвета чередуются, партия длится не больше
+// 60 ударов (дальше — по материалу).
+//
+// physicsbench --eval [файл весов]: скорость оценки позиций из случайных
+// партий — эвристика evaluateMove (на удар), MaterialEvaluator, извлечение
+// признаков и обученная модель по одной и пакетом (evaluateBatch). Без файла
+// берутся случайные веса MLP: на скорость это не влияет.
+
+#include "gamelogic.h"
+#include "botplayer.h"
+#include "analyticsim.h"
+#include "shotbatch.h"
+#include "workpool.h"
+#include "evaluator.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+
+static void setupBoard(GameLogic &logic, int cells, QRandomGenerator &rng)
+{
+    logic.boardLeft = 100;
+    logic.boardTop = 100;
+    logic.boardSize = 600.0f * cells / 8.0f; // клетка всегда 75 px
+    logic.boardCells = cells;
+    logic.initBoard(cells / 4);
+
+    for (int i = 0; i < logic.getCheckerCount(); ++i) {
+        float fx = static_cast<float>(rng.bounded(600.0) - 300.0);
+        float fy = static_cast<float>(rng.bounded(600.0) - 300.0);
+        logic.shoot(i, QPointF(fx, fy));
+    }
+}
+
+static int runValidation()
+{
+    const int SHOTS = 200;
+    // Шаг игры, вдвое мельче и вдвое крупнее: исход не должен зависеть от шага
+    const float STEPS[] = { GameLogic::PHYSICS_STEP / 2, GameLogic::PHYSICS_STEP, GameLogic::PHYSICS_STEP * 2 };
+    const float MEAN_TOLERANCE = 1.0f; // px
+    // Худший удар: на крупном шаге столкновение в упор решается чуть иначе
+    // (сейчас до 6.9 px на шаге 0.032)
+    const float WORST_TOLERANCE = 8.0f; // px
+    QRandomGenerator rng(777);
+    GameLogic logic;
+    logic.initBoard();
+
+    QVector<int> checkers;
+    QVector<QPointF> forces;
+    for (int shot = 0; shot < SHOTS; ++shot) {
+        const double angle = rng.bounded(2.0 * 3.14159265);
+        const double power = 100.0 + rng.bounded(575.0); // до 500 * botSpeedMultiplier(Hard)
+        checkers.push_back(rng.bounded(logic.getCheckerCount()));
+        forces.push_back(QPointF(std::cos(angle) * power, std::sin(angle) * power));
+    }
+
+    bool ok = true;
+    std::printf("shots: %d\n", SHOTS);
+    std::printf("%8s %10s %10s %10s %12s\n", "step, s", "mean, px", "worst, px", "mismatch", "steps/shot");
+    for (float step : STEPS) {
+        float worstError = 0.0f;
+        double meanErrorSum = 0.0;
+        int mismatches = 0;
+        long long steps = 0;
+        for (int shot = 0; shot < SHOTS; ++shot) {
+            AnalyticSimulator::Validation v = AnalyticSimulator::validate(logic, checkers[shot], forces[shot], step);
+            worstError = qMax(worstError, v.maxError);
+            meanErrorSum += v.meanError;
+            mismatches += v.aliveMismatch;
+            steps += v.steps;
+        }
+        std::printf("%8.3f %10.3f %10.3f %10d %12.1f\n", step, meanErrorSum / SHOTS, worstError,
+                    mismatches, double(steps) / SHOTS);
+        ok = ok && meanErrorSum / SHOTS <= MEAN_TOLERANCE;
+        ok = ok && worstError <= WORST_TOLERANCE;
+        ok = ok && mismatches == 0;
+    }
+
+    // Время каждого движка на шаге игры
+    qint64 steppedNs = 0;
+    qint64 analyticNs = 0;
+    long long events = 0;
+    for (int shot = 0; shot < SHOTS; ++shot) {
+        QElapsedTimer timer;
+        timer.start();
+        GameLogic stepped = logic;
+        stepped.shoot(checkers[shot], forces[shot]);
+        do { stepped.update(GameLogic::PHYSICS_STEP); } while (stepped.isMoving());
+        steppedNs += timer.nsecsElapsed();
+
+        timer.start();
+        CheckerStore pieces = logic.checkerStore();
+        events += AnalyticSimulator(logic.geometry()).simulateShot(pieces, checkers[shot], forces[shot]).events;
+        analyticNs += timer.nsecsElapsed();
+    }
+    std::printf("stepped:  %.2f us/shot\n", steppedNs / 1000.0 / SHOTS);
+    std::printf("analytic: %.1f events/shot, %.2f us/shot\n",
+                double(events) / SHOTS, analyticNs / 1000.0 / SHOTS);
+    std::printf("%s: want mean error <= %.1f px, worst <= %.1f px, no alive mismatches at every step\n",
+                ok ? "PASS" : "FAIL", MEAN_TOLERANCE, WORST_TOLERANCE);
+    return ok ? 0 : 1;
+}
+
+static int runBatch()
+{
+    GameLogic logic;
+    logic.initBoard();
+    const BoardSnapshot snapshot = logic.snapshot();
+
+    // Все шашки x 64 направления x 8 сил
+    QVector<ShotCandidate> candidates;
+    for (int i = 0; i < logic.getCheckerCount(); ++i) {
+        for (int a = 0; a < 64; ++a) {
+            const double angle = a * 2.0 * 3.14159265 / 64;
+            for (int p = 1; p <= 8; ++p) {
+                const double power = p * 80.0;
+                candidates.push_back({ i, QPointF(std::cos(angle) * power, std::sin(angle) * power) });
+            }
+        }
+    }
+
+    const int maxThreads = qMax(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::printf("%d candidates per batch\n", int(candidates.size()));
+    std::printf("%8s %16s\n", "threads", "candidates/s");
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        WorkPool pool(threads);
+        ShotBatch batch(&pool);
+        batch.run(snapshot, candidates); // прогрев буферов
+
+        QElapsedTimer timer;
+        timer.start();
+        int batches = 0;
+        while (timer.elapsed() < 1000 || batches < 3) {
+            batch.run(snapshot, candidates);
+            ++batches;
+        }
+        const double seconds = timer.nsecsElapsed() / 1e9;
+        std::printf("%8d %16.0f\n", threads, batches * candidates.size() / seconds);
+        if (threads < maxThreads && threads * 2 > maxThreads) threads = maxThreads / 2;
+    }
+    return 0;
+}
+
+// Доигрывает удар пошаговой физикой игры
+static void playShot(GameLogic &game, const BotMove &move)
+{
+    if (move.checkerIndex < 0) return;
+    game.shoot(move.checkerIndex, move.force);
+    int steps = 0;
+    do { game.update(GameLogic::PHYSICS_STEP); } while (game.isMoving() && ++steps < 10000);
+}
+
+// Прежний поиск findBestMove: 17 углов вокруг направления на ближайшего
+// врага x 4 силы для каждой шашки (разброс и силы уровня Hard)
+static BotMove legacyGridSearch(const GameLogic &logic, Side side, int &evaluations)
+{
+    const float angleSpreadDeg = 22.0f;
+    const int powerMin = 140;
+    const int powerMax = 400;
+    BotMove best = { -1, QPointF(0, 0), -1e30f };
+    evaluations = 0;
+    for (int c : logic.getCheckersOf(side)) {
+        const QPointF from = logic.getCheckerPosition(c);
+        QPointF target = from + QPointF(0, logic.boardSize * 0.2f);
+        float bestD2 = 1e18f;
+        for (int e : logic.getCheckersOf(opponentOf(side))) {
+            const QPointF d = logic.getCheckerPosition(e) - from;
+            const float d2 = float(d.x() * d.x() + d.y() * d.y());
+            if (d2 < bestD2) { bestD2 = d2; target = logic.getCheckerPosition(e); }
+        }
+        const float baseAngle = float(std::atan2(target.y() - from.y(), target.x() - from.x())) * 180.0f / 3.14159265f;
+        for (int s = -8; s <= 8; ++s) {
+            const float rad = (baseAngle + s / 8.0f * angleSpreadDeg) * 3.14159265f / 180.0f;
+            for (int power = powerMin; power <= powerMax; power += (powerMax - powerMin) / 3 + 1) {
+                const QPointF force(std::cos(rad) * power, std::sin(rad) * power);
+                const float score = logic.evaluateMove(c, force);
+                evaluations++;
+                if (score > best.score) best = { c, force, score };
+            }
+        }
+    }
+    return best;
+}
+
+// Эталон: все шашки x 360 направлений x 32 силы в той же области, что у searchShot
+static float referenceBest(const GameLogic &logic, Side side)
+{
+    float best = -1e30f;
+    for (int c : logic.getCheckersOf(side)) {
+        for (int a = 0; a < 360; ++a) {
+            const double rad = a * 3.14159265 / 180.0;
+            for (int p = 0; p < 32; ++p) {
+                const double power = 90.0 + p * (400.0 - 90.0) / 31.0;
+                best = qMax(best, logic.evaluateMove(c, QPointF(std::cos(rad) * power, std::sin(rad) * power)));
+            }
+        }
+    }
+    return best;
+}
+
+static int runSearchQuality()
+{
+    const int POSITIONS = 100;
+    const float NEAR_BEST = 10.0f; // очков evaluateMove: "почти лучший" удар
+    const int budgets[] = { 24, 48, 96, 160, 320, 480 };
+    const int budgetCount = int(sizeof(budgets) / sizeof(budgets[0]));
+
+    QRandomGenerator rng(4242);
+    double legacyRegret = 0.0;
+    int legacyNear = 0;
+    long long legacyEvals = 0;
+    double regret[budgetCount] = {};
+    int nearBest[budgetCount] = {};
+    qint64 searchNs[budgetCount] = {};
+    int measured = 0;
+
+    for (int pos = 0; pos < POSITIONS; ++pos) {
+        // Разбрасываем стартовую расстановку несколькими случайными ударами
+        GameLogic logic;
+        logic.initBoard();
+        const int scatter = 2 + rng.bounded(6);
+        for (int k = 0; k < scatter; ++k) {
+            const double angle = rng.bounded(2.0 * 3.14159265);
+            const double power = 150.0 + rng.bounded(350.0);
+            playShot(logic, { rng.bounded(logic.getCheckerCount()),
+                              QPointF(std::cos(angle) * power, std::sin(angle) * power), 0.0f });
+        }
+        const Side side = (pos % 2 == 0) ? Side::Black : Side::White;
+        if (logic.aliveCount(Side::White) == 0 || logic.aliveCount(Side::Black) == 0) continue;
+
+        const float reference = referenceBest(logic, side);
+        measured++;
+
+        int evaluations = 0;
+        const BotMove legacy = legacyGridSearch(logic, side, evaluations);
+        legacyRegret += reference - legacy.score;
+        legacyNear += (reference - legacy.score <= NEAR_BEST);
+        legacyEvals += evaluations;
+
+        for (int b = 0; b < budgetCount; ++b) {
+            QElapsedTimer timer;
+            timer.start();
+            const BotMove found = logic.searchShot(side, budgets[b]);
+            searchNs[b] += timer.nsecsElapsed();
+            regret[b] += reference - found.score;
+            nearBest[b] += (reference - found.score <= NEAR_BEST);
+        }
+    }
+
+    const int m = qMax(1, measured);
+    std::printf("%d positions, regret = reference best score - found score\n", measured);
+    std::printf("%-14s %8s %12s %12s %10s\n", "search", "evals", "mean regret", "near best", "us/move");
+    std::printf("%-14s %8.0f %12.1f %11d%% %10s\n", "legacy grid",
+                double(legacyEvals) / m, legacyRegret / m, legacyNear * 100 / m, "-");
+    for (int b = 0; b < budgetCount; ++b) {
+        std::printf("%-14s %8d %12.1f %11d%% %10.1f\n", "adaptive", budgets[b],
+                    regret[b] / m, nearBest[b] * 100 / m, searchNs[b] / 1000.0 / m);
+    }
+    return 0;
+}
+
+static int runSelfPlay(int games, int threads, double budgetScale)
+{
+    const int MAX_SHOTS = 60;
+
+    // Оба бота — BotPlayer, как в окне: поиск, запасной ход и множитель силы
+    // уровня. Бюджет Master — время хода Hard, умноженное на budgetScale
+    BotConfig hardConfig;
+    hardConfig.difficulty = Hard;
+    hardConfig.threads = threads;
+    hardConfig.useBook = false;
+    BotConfig masterConfig = hardConfig;
+    masterConfig.difficulty = Master;
+    masterConfig.budgetMs = float(hardConfig.limits().budgetMs * budgetScale);
+
+    int wins = 0, draws = 0, losses = 0;
+    qint64 masterNs = 0, hardNs = 0, masterShots = 0, hardShots = 0;
+    int masterMoves = 0, hardMoves = 0;
+
+    for (int g = 0; g < games; ++g) {
+        GameLogic game;
+        game.initBoard();
+        BotPlayer master(masterConfig, quint32(2 * g + 1));
+        BotPlayer hard(hardConfig, quint32(2 * g + 2));
+
+        const Side masterSide = (g % 2 == 0) ? Side::Black : Side::White;
+        Side toMove = Side::White;
+        for (int shot = 0; shot < MAX_SHOTS; ++shot) {
+            if (game.aliveCount(Side::White) == 0 || game.aliveCount(Side::Black) == 0) break;
+            BotPlayer &player = toMove == masterSide ? master : hard;
+            playShot(game, player.chooseMove(game, toMove));
+            toMove = opponentOf(toMove);
+        }
+        masterNs += master.thinkNs();
+        masterMoves += master.moves();
+        masterShots += master.searchShots();
+        hardNs += hard.thinkNs();
+        hardMoves += hard.moves();
+        hardShots += hard.searchShots();
+
+        const int own = game.aliveCount(masterSide);
+        const int enemy = game.aliveCount(opponentOf(masterSide));
+        const char *result = own > enemy ? "win" : own < enemy ? "loss" : "draw";
+        if (own > enemy) wins++;
+        else if (own < enemy) losses++;
+        else draws++;
+        std::printf("game %3d: Master %s, %d:%d %s\n", g + 1,
+                    masterSide == Side::White ? "white" : "black", own, enemy, result);
+    }
+
+    // Доля очков (ничья — пол-очка) и 95% интервал Уилсона
+    const double n = games;
+    const double p = (wins + 0.5 * draws) / n;
+    const double z = 1.96;
+    const double centre = (p + z * z / (2 * n)) / (1 + z * z / n);
+    const double half = z * std::sqrt(p * (1 - p) / n + z * z / (4 * n * n)) / (1 + z * z / n);
+
+    std::printf("\nMaster vs Hard: +%d =%d -%d, score %.1f%% (95%% CI %.1f..%.1f%%)\n",
+                wins, draws, losses, 100 * p, 100 * (centre - half), 100 * (centre + half));
+    std::printf("budget, ms/move: Master %.1f, Hard %.1f\n", double(masterConfig.limits().budgetMs),
+                double(hardConfig.limits().budgetMs));
+    std::printf("think time, ms/move: Master %.2f, Hard %.2f\n",
+                masterNs / 1e6 / qMax(1, masterMoves), hardNs / 1e6 / qMax(1, hardMoves));
+    std::printf("search shots/move: Master %.0f, Hard %.0f\n",
+                double(masterShots) / qMax(1, masterMoves), double(hardShots) / qMax(1, hardMoves));
+    return 0;
+}
+
+// Оценок в миллисекунду: fn(k) вызывается для k = 0, 1, ... не меньше ~0.3 с
+template <typename Fn>
+static double evalsPerMs(Fn fn)
+{
+    QElapsedTimer timer;
+    timer.start();
+    long long calls = 0;
+    volatile float sink = 0.0f;
+    while (timer.nsecsElapsed() < 300000000LL) {
+        for (int k = 0; k < 1024; ++k) sink = sink + fn(calls++);
+    }
+    return calls / (timer.nsecsElapsed() / 1e6);
+}
+
+static int runEval(const char *weightsPath)
+{
+    LearnedEvaluator learned;
+    if (weightsPath) {
+        if (!learned.load(QString::fromLocal8Bit(weightsPath))) {
+            std::fprintf(stderr, "cannot load %s\n", weightsPath);
+            return 1;
+        }
+    } else {
+        QRandomGenerator wr(7);
+        LearnedEvaluator::Weights w;
+        for (int i = 0; i < LearnedEvaluator::FEATURES; ++i) w.stddev[i] = 1.0f;
+        for (auto &row : w.w1) for (float &v : row) v = float(wr.generateDouble() - 0.5);
+        for (float &v : w.w2) v = float(wr.generateDouble() - 0.5);
+        learned.setWeights(w);
+    }
+
+    // Позиции из партий случайными ударами (после каждого удара, пока обе стороны в игре)
+    const int POSITIONS = 512;
+    QVector<GameLogic> games;
+    QVector<BotMove> moves;
+    QRandomGenerator rng(99);
+    while (games.size() < POSITIONS) {
+        GameLogic game;
+        game.initBoard();
+        Side side = Side::White;
+        for (int shot = 0; shot < 40 && games.size() < POSITIONS; ++shot) {
+            if (game.aliveCount(Side::White) == 0 || game.aliveCount(Side::Black) == 0) break;
+            const QVector<int> own = game.getCheckersOf(side);
+            const double angle = rng.generateDouble() * 2.0 * 3.14159265;
+            const double power = 90.0 + rng.bounded(310.0);
+            const BotMove move = { own[rng.bounded(int(own.size()))],
+                                   QPointF(std::cos(angle) * power, std::sin(angle) * power), 0.0f };
+            games.push_back(game);
+            moves.push_back(move);
+            playShot(game, move);
+            side = opponentOf(side);
+        }
+    }
+
+    const int F = LearnedEvaluator::FEATURES;
+    QVector<float> features(POSITIONS * F);
+    for (int k = 0; k < POSITIONS; ++k) {
+        EvalFeatures::extract(games[k].checkerStore(), games[k].geometry(), Side::White, Side::White,
+                              features.data() + k * F);
+    }
+    const MaterialEvaluator material;
+    const int mask = POSITIONS - 1;
+
+    const double heuristic = evalsPerMs([&](long long k) {
+        const int p = int(k & mask);
+        return games[p].evaluateMove(moves[p].checkerIndex, moves[p].force);
+    });
+    const double materialRate = evalsPerMs([&](long long k) {
+        const GameLogic &g = games[int(k & mask)];
+        return material.evaluate(g.checkerStore(), g.geometry(), Side::White, Side::White);
+    });
+    const double extractRate = evalsPerMs([&](long long k) {
+        const GameLogic &g = games[int(k & mask)];
+        float x[LearnedEvaluator::FEATURES];
+        EvalFeatures::extract(g.checkerStore(), g.geometry(), Side::White, Side::White, x);
+        return x[0];
+    });
+    const double single = evalsPerMs([&](long long k) {
+        const GameLogic &g = games[int(k & mask)];
+        return learned.evaluate(g.checkerStore(), g.geometry(), Side::White, Side::White);
+    });
+    QVector<float> out(POSITIONS);
+    const double batch = POSITIONS * evalsPerMs([&](long long) {
+        learned.evaluateBatch(features.constData(), POSITIONS, out.data());
+        return out[0];
+    });
+
+    std::printf("%d positions, model %s%s\n", POSITIONS,
+                learned.modelType() == LearnedEvaluator::Mlp ? "mlp" : "linear",
+                weightsPath ? "" : " (random weights)");
+    std::printf("%-34s %12s\n", "", "evals/ms");
+    std::printf("%-34s %12.0f\n", "evaluateMove (heuristic, per shot)", heuristic);
+    std::printf("%-34s %12.0f\n", "MaterialEvaluator", materialRate);
+    std::printf("%-34s %12.0f\n", "EvalFeatures::extract", extractRate);
+    std::printf("%-34s %12.0f\n", "LearnedEvaluator::evaluate", single);
+    std::printf("%-34s %12.0f\n", "LearnedEvaluator::evaluateBatch", batch);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "--validate") == 0) {
+        return runValidation();
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        return runBatch();
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--search") == 0) {
+        return runSearchQuality();
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--selfplay") == 0) {
+        const int games = argc > 2 ? std::atoi(argv[2]) : 20;
+        const int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+        const double scale = argc > 4 ? std::atof(argv[4]) : 1.0;
+        return runSelfPlay(qMax(1, games), threads, scale > 0.0 ? scale : 1.0);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--eval") == 0) {
+        return runEval(argc > 2 ? argv[2] : nullptr);
+    }
+
+    const int STEPS = 300;
+    const float DT = 0.016f;
+
+    std::printf("%8s %14s %14s\n", "pieces", "us/step", "ns/piece/step");
+    for (int cells = 8; cells <= 128; cells *= 2) {
+        QRandomGenerator rng(12345);
+        GameLogic logic;
+        qint64 totalNs = 0;
+        int runs = 0;
+
+        // Повторяем, пока не наберётся хотя бы ~0.5 с измерений
+        while (totalNs < 500000000LL || runs < 3) {
+            setupBoard(logic, cells, rng);
+            QElapsedTimer timer;
+            timer.start();
+            for (int s = 0; s < STEPS; ++s) logic.update(DT);
+            totalNs += timer.nsecsElapsed();
+            ++runs;
+        }
+
+        const int pieces = logic.getCheckerCount();
+        const double nsPerStep = double(totalNs) / (double(runs) * STEPS);
+        std::printf("%8d %14.2f %14.2f\n", pieces, nsPerStep / 1000.0, nsPerStep / pieces);
+    }
+    return 0;
+}
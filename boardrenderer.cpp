@@ -0,0 +1,197 @@
+#include "boardrenderer.h"
+#include "gamelogic.h"
+#include "shotheatmap.h"
+#include "trace.h"
+#include <QtMath>
+#include <cmath>
+
+void BoardRenderer::drawStatic(QPainter *p, const QRegion &dirty, const QSize &size, qreal dpr,
+                               const QPixmap &background, const GameLogic &logic)
+{
+    TRACE_ZONE("BoardRenderer::drawStatic");
+    StaticKey key;
+    key.size = size;
+    key.dpr = dpr;
+    key.background = background.cacheKey();
+    key.boardLeft = logic.boardLeft;
+    key.boardTop = logic.boardTop;
+    key.boardSize = logic.boardSize;
+    key.boardCells = logic.boardCells;
+
+    if (staticLayer.isNull() || !(key == staticKey)) {
+        staticKey = key;
+        renderStatic(background, logic);
+    }
+
+    // Копируются только перерисовываемые прямоугольники (источник — в пикселях устройства)
+    for (const QRect &r : dirty) {
+        p->drawPixmap(QRectF(r), staticLayer,
+                      QRectF(r.x() * dpr, r.y() * dpr, r.width() * dpr, r.height() * dpr));
+    }
+}
+
+// Пересборка неподвижного слоя: пиксмап в физических пикселях экрана, а
+// рисование — в логических координатах виджета, как и всё остальное
+void BoardRenderer::renderStatic(const QPixmap &background, const GameLogic &logic)
+{
+    const QSize size = staticKey.size;
+    const qreal dpr = staticKey.dpr;
+    staticLayer = QPixmap(qMax(1, qRound(size.width() * dpr)), qMax(1, qRound(size.height() * dpr)));
+    staticLayer.setDevicePixelRatio(dpr);
+
+    QPainter p(&staticLayer);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    const QRect rect(QPoint(0, 0), size);
+    if (!background.isNull()) {
+        p.drawPixmap(rect, background);
+    } else {
+        p.fillRect(rect, QColor(44, 62, 80));
+    }
+
+    const float cell = logic.cellSize();
+
+    // Рисуем клетки доски
+    for (int row = 0; row < logic.boardCells; ++row) {
+        for (int col = 0; col < logic.boardCells; ++col) {
+            QRectF cellRect(
+                logic.boardLeft + col * cell,
+                logic.boardTop + row * cell,
+                cell,
+                cell
+                );
+
+            // Чередуем цвета клеток
+            if ((row + col) % 2 == 0) {
+                p.fillRect(cellRect, QColor(240, 217, 181)); // Светлые клетки
+            } else {
+                p.fillRect(cellRect, QColor(181, 136, 99));  // Темные клетки
+            }
+        }
+    }
+
+    // Рамка доски
+    p.setPen(QPen(Qt::black, 3));
+    p.drawRect(QRectF(logic.boardLeft, logic.boardTop, logic.boardSize, logic.boardSize));
+}
+
+QRect BoardRenderer::pieceRect(const QPointF &pos, float radius)
+{
+    const float reach = radius + SPRITE_MARGIN + 1.0f; // и кайма спрайта
+    return QRectF(pos.x() - reach, pos.y() - reach, 2.0f * reach, 2.0f * reach).toAlignedRect();
+}
+
+// Одна шашка векторно — так спрайты рисуются в атлас; ring — цвет кольца
+// выделения (недействительный — без кольца)
+static void drawPiece(QPainter *p, const QPointF &pos, float radius, bool white, const QColor &ring)
+{
+    // Основной круг шашки
+    p->setBrush(white ? Qt::white : Qt::black);
+    p->setPen(QPen(Qt::black, 2));
+    p->drawEllipse(pos, radius, radius);
+
+    // Добавляем ободок для лучшего визуального эффекта
+    if (white) {
+        p->setPen(QPen(QColor(200, 200, 200), 1));
+        p->drawEllipse(pos, radius - 2, radius - 2);
+    } else {
+        p->setPen(QPen(QColor(50, 50, 50), 1));
+        p->drawEllipse(pos, radius - 2, radius - 2);
+    }
+
+    if (ring.isValid()) {
+        p->setBrush(Qt::NoBrush);
+        p->setPen(QPen(ring, 3));
+        p->drawEllipse(pos, radius + 1.5f, radius + 1.5f);
+    }
+}
+
+// Атлас: ряд белых и ряд чёрных спрайтов, в ряду — по одному на вид. Спрайт
+// рисуется в пикселях устройства, с прозрачной каймой в пиксель, чтобы при
+// сглаженном переносе на дробную позицию не подтекали соседи.
+void BoardRenderer::renderAtlas(float radius, qreal dpr)
+{
+    atlasRadius = radius;
+    atlasDpr = dpr;
+    spriteSide = qCeil(2.0 * (radius + SPRITE_MARGIN) * dpr) + 2;
+    atlas = QPixmap(spriteSide * LOOKS, spriteSide * 2);
+    atlas.fill(Qt::transparent);
+
+    QPainter p(&atlas);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.scale(dpr, dpr);
+    // Выбранная — золотое кольцо, подсвеченная — голубое
+    const QColor rings[LOOKS] = { QColor(), QColor(255, 215, 0), QColor(135, 206, 250) };
+    for (int row = 0; row < 2; ++row) {
+        for (int look = 0; look < LOOKS; ++look) {
+            const QPointF center((look + 0.5) * spriteSide / dpr, (row + 0.5) * spriteSide / dpr);
+            drawPiece(&p, center, radius, row == 0, rings[look]);
+        }
+    }
+}
+
+void BoardRenderer::drawPieces(QPainter *p, const QRegion &dirty, const GameLogic &logic, float alpha,
+                               int selected, int highlighted)
+{
+    TRACE_ZONE("BoardRenderer::drawPieces");
+    const float radius = logic.checkerRadius();
+    const qreal dpr = p->device()->devicePixelRatioF();
+    if (atlas.isNull() || atlasRadius != radius || atlasDpr != dpr) renderAtlas(radius, dpr);
+
+    // Спрайт переносится 1:1 к пикселям устройства; дробная позиция —
+    // билинейным сдвигом
+    p->save();
+    p->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    const qreal half = spriteSide / (2.0 * dpr);
+
+    // Рисуем шашки
+    const CheckersView checkers = logic.checkersView();
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (!checkers.isAlive(i)) continue;
+
+        // Интерполируем между предыдущим и текущим физическим состоянием
+        const QPointF pos = logic.renderPosition(i, alpha);
+        if (!dirty.intersects(pieceRect(pos, radius))) continue;
+
+        const int row = checkers.side[i] == Side::White ? 0 : 1;
+        const int look = i == selected ? Selected : i == highlighted ? Highlighted : Plain;
+        p->drawPixmap(QRectF(pos.x() - half, pos.y() - half, 2 * half, 2 * half), atlas,
+                      QRectF(look * spriteSide, row * spriteSide, spriteSide, spriteSide));
+    }
+    p->restore();
+}
+
+QImage BoardRenderer::heatmapImage(const ShotHeatmap &map, float inner, float outer)
+{
+    const int side = qMax(1, static_cast<int>(std::ceil(outer)));
+    QImage image(side, side, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    const float twoPi = 2.0f * 3.14159265f;
+    for (int y = 0; y < side; ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < side; ++x) {
+            // Пиксель картинки — квадрат 2x2 на экране, центр картинки — центр шашки
+            const float dx = (x + 0.5f) * 2.0f - outer;
+            const float dy = (y + 0.5f) * 2.0f - outer;
+            const float r = std::sqrt(dx * dx + dy * dy);
+            if (r < inner || r >= outer) continue;
+
+            float angle = std::atan2(dy, dx);
+            if (angle < 0.0f) angle += twoPi;
+            const int a = qMin(ShotHeatmap::ANGLES - 1, static_cast<int>(angle / twoPi * ShotHeatmap::ANGLES));
+            const int p = qMin(ShotHeatmap::POWERS - 1,
+                               static_cast<int>((r - inner) / (outer - inner) * ShotHeatmap::POWERS));
+            const float v = map.value(a, p);
+            if (std::isnan(v)) continue;
+
+            // Выигрыш материала — зелёный, потеря — красный, без изменений — серый
+            QRgb color;
+            if (v > 0.0f) color = qRgba(46, 204, 113, qMin(220, 110 + 50 * static_cast<int>(v)));
+            else if (v < 0.0f) color = qRgba(231, 76, 60, qMin(220, 110 - 50 * static_cast<int>(v)));
+            else color = qRgba(127, 140, 141, 50);
+            line[x] = qPremultiply(color);
+        }
+    }
+    return image;
+}
@@ -0,0 +1,77 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <QPainter>
+#include <QImage>
+#include <QPixmap>
+#include <QRegion>
+
+class GameLogic;
+class ShotHeatmap;
+
+// Отрисовка доски и шашек (вынесена из GameLogic, чтобы ядро не зависело от QtGui).
+//
+// Кадр собирается из слоёв: неподвижный слой (фон, растянутый на окно, и
+// клетки доски с рамкой) заранее отрисован в пиксмап с учётом devicePixelRatio
+// и пересобирается только при смене размера окна, DPR, геометрии доски или
+// фона; поверх него каждый кадр рисуются шашки и интерфейс.
+//
+// Шашки не растеризуются заново в каждом кадре: все их виды (белая и
+// чёрная, обычная, выбранная, подсвеченная) один раз рисуются в атлас под
+// текущий радиус и DPR, а в кадре переносятся из него спрайтами.
+//
+// Рисуется только область dirty (перерисовываемая часть виджета): из слоя
+// копируются её прямоугольники, шашки вне неё пропускаются.
+class BoardRenderer
+{
+public:
+    // Неподвижный слой на весь виджет размера size (фон — background или
+    // заливка, если его нет)
+    void drawStatic(QPainter *p, const QRegion &dirty, const QSize &size, qreal dpr,
+                    const QPixmap &background, const GameLogic &logic);
+    // Шашки; alpha — доля пути между двумя последними физическими шагами,
+    // selected и highlighted — шашки с кольцом выделения (-1 — нет)
+    void drawPieces(QPainter *p, const QRegion &dirty, const GameLogic &logic, float alpha,
+                    int selected = -1, int highlighted = -1);
+    // Прямоугольник, который закрашивает шашка с центром pos
+    static QRect pieceRect(const QPointF &pos, float radius);
+
+    // Полярная карта ударов вокруг шашки: направление — угол удара, удаление
+    // от центра (от inner до outer) — сила. Картинка в половинном разрешении
+    // со стороной outer (рисуется растянутой вдвое), незаполненные клетки прозрачны.
+    static QImage heatmapImage(const ShotHeatmap &map, float inner, float outer);
+
+private:
+    // Ключ неподвижного слоя: всё, от чего зависит его содержимое
+    struct StaticKey {
+        QSize size;
+        qreal dpr = 0.0;
+        qint64 background = 0;
+        float boardLeft = 0.0f;
+        float boardTop = 0.0f;
+        float boardSize = 0.0f;
+        int boardCells = 0;
+
+        bool operator==(const StaticKey &o) const
+        {
+            return size == o.size && dpr == o.dpr && background == o.background
+                && boardLeft == o.boardLeft && boardTop == o.boardTop
+                && boardSize == o.boardSize && boardCells == o.boardCells;
+        }
+    };
+
+    QPixmap staticLayer;
+    StaticKey staticKey;
+
+    enum PieceLook { Plain, Selected, Highlighted, LOOKS };
+    static constexpr float SPRITE_MARGIN = 4.0f; // обводка и кольцо вокруг радиуса
+    QPixmap atlas;           // в пикселях устройства, без devicePixelRatio
+    float atlasRadius = 0.0f;
+    qreal atlasDpr = 0.0;
+    int spriteSide = 0;      // сторона спрайта в пикселях устройства
+
+    void renderStatic(const QPixmap &background, const GameLogic &logic);
+    void renderAtlas(float radius, qreal dpr);
+};
+
+#endif // BOARDRENDERER_H
@@ -0,0 +1,119 @@
+// Генератор дебютной книги.
+//
+// bookgen [файл] [мс на позицию]
+//
+// Глубокий MCTS (по умолчанию 3 с на позицию на всех ядрах) ищет ход для
+// стартовой позиции initBoard() за обе стороны и ответ чёрных на частые
+// первые удары белых: ходы ботов Easy/Medium/Hard (через BotPlayer, как в
+// окне, вместе с множителем силы уровня), книжный ход белых и прямые удары
+// каждой белой шашкой в ближайшую чёрную тремя силами.
+// Позиции после удара разыгрываются пошаговой физикой игры — ровно той,
+// что работает в окне. Результат — opening.book; его нужно положить рядом
+// с исполняемым файлом игры.
+
+#include "botplayer.h"
+#include "gamelogic.h"
+#include "mctsbot.h"
+#include "openingbook.h"
+#include "shotcache.h"
+#include <QElapsedTimer>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+static void playShot(GameLogic &game, int checker, const QPointF &force)
+{
+    game.shoot(checker, force);
+    int steps = 0;
+    do { game.update(GameLogic::PHYSICS_STEP); } while (game.isMoving() && ++steps < 10000);
+}
+
+static BotMove deepSearch(MctsBot &mcts, const GameLogic &game, Side side)
+{
+    QElapsedTimer timer;
+    timer.start();
+    mcts.reset();
+    const BotMove move = mcts.search(game.snapshot(), side);
+    const MctsBot::Stats &s = mcts.lastStats();
+    std::printf("  %s to move: checker %2d, value %.3f, %d iterations, %.1f s\n",
+                side == Side::White ? "white" : "black", move.checkerIndex, s.value,
+                s.iterations, timer.nsecsElapsed() / 1e9);
+    return move;
+}
+
+int main(int argc, char *argv[])
+{
+    const QString path = argc > 1 ? QString::fromLocal8Bit(argv[1]) : QString("opening.book");
+    const float budgetMs = argc > 2 ? float(std::atof(argv[2])) : 3000.0f;
+
+    MctsConfig cfg;
+    cfg.budgetMs = budgetMs > 0.0f ? budgetMs : 3000.0f;
+    cfg.rolloutShots = 3;
+    ShotCache cache;
+    MctsBot mcts;
+    mcts.setConfig(cfg);
+    mcts.setShotCache(&cache);
+
+    GameLogic start;
+    start.initBoard();
+    QVector<OpeningBook::Entry> entries;
+
+    std::printf("start position\n");
+    const BotMove whiteFirst = deepSearch(mcts, start, Side::White);
+    entries.push_back({ start.snapshot(), Side::White, whiteFirst });
+    entries.push_back({ start.snapshot(), Side::Black, deepSearch(mcts, start, Side::Black) });
+
+    // Частые первые удары белых
+    QVector<BotMove> openings;
+    openings.push_back(whiteFirst);
+    for (BotDifficulty d : { Easy, Medium, Hard }) {
+        BotConfig bc;
+        bc.difficulty = d;
+        bc.useBook = false; // книга ещё не записана
+        BotPlayer bot(bc);
+        openings.push_back(bot.chooseMove(start, Side::White));
+    }
+    for (int w : start.getWhiteCheckers()) {
+        const QPointF from = start.getCheckerPosition(w);
+        QPointF target = from;
+        float bestD2 = 1e18f;
+        for (int b : start.getBlackCheckers()) {
+            const QPointF d = start.getCheckerPosition(b) - from;
+            const float d2 = float(d.x() * d.x() + d.y() * d.y());
+            if (d2 < bestD2) { bestD2 = d2; target = start.getCheckerPosition(b); }
+        }
+        const QPointF dir = (target - from) / std::sqrt(bestD2);
+        for (float power : { 160.0f, 280.0f, 400.0f }) {
+            openings.push_back({ w, dir * power, 0.0f });
+        }
+    }
+
+    for (int k = 0; k < openings.size(); ++k) {
+        const BotMove &o = openings[k];
+        if (o.checkerIndex < 0) continue;
+        GameLogic after = start;
+        playShot(after, o.checkerIndex, o.force);
+        if (after.aliveCount(Side::White) == 0 || after.aliveCount(Side::Black) == 0) continue;
+
+        std::printf("opening %d/%d: white checker %d, force (%.0f, %.0f)\n", k + 1, int(openings.size()),
+                    o.checkerIndex, o.force.x(), o.force.y());
+        entries.push_back({ after.snapshot(), Side::Black, deepSearch(mcts, after, Side::Black) });
+    }
+
+    if (!OpeningBook::write(path, entries)) {
+        std::fprintf(stderr, "cannot write %s\n", qPrintable(path));
+        return 1;
+    }
+
+    // Проверка: каждая позиция находится в записанной книге
+    OpeningBook book;
+    int found = 0;
+    if (book.open(path)) {
+        for (const OpeningBook::Entry &e : entries) {
+            BotMove m;
+            found += book.lookup(e.position, e.toMove, m) && m.checkerIndex == e.move.checkerIndex;
+        }
+    }
+    std::printf("%d entries written to %s, %d found on reload\n", int(entries.size()), qPrintable(path), found);
+    return found == entries.size() ? 0 : 1;
+}
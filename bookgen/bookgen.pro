@@ -0,0 +1,11 @@
+# Генератор дебютной книги (консольная утилита, только QtCore)
+QT = core
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = bookgen
+
+include(../core/core.pri)
+
+SOURCES += \
+    bookgen.cpp
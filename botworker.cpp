@@ -0,0 +1,75 @@
+#include "botworker.h"
+#include "evaluator.h"
+#include "openingbook.h"
+#include "trace.h"
+
+BotWorker::BotWorker(QObject *parent)
+    : QObject(parent), player(BotConfig(), QRandomGenerator::global()->generate()),
+    requestId(0), thinking(false)
+{
+    qRegisterMetaType<BotMove>("BotMove");
+    player.setOpeningBook(&OpeningBook::shared());
+    // Обученная оценка для поиска (MCTS и AnytimeBot), если рядом лежит evaluator.weights
+    const LearnedEvaluator &learned = LearnedEvaluator::shared();
+    if (learned.isLoaded()) player.setEvaluator(&learned);
+
+    // searchFinished испускается из потока поиска — соединение с собой
+    // становится очередным, и обработчик выполняется уже в GUI-потоке
+    connect(this, &BotWorker::searchFinished, this, &BotWorker::onSearchFinished,
+            Qt::QueuedConnection);
+}
+
+BotWorker::~BotWorker()
+{
+    cancel();
+    waitForThread();
+}
+
+void BotWorker::start(const GameLogic &snapshot, Side side)
+{
+    cancel();
+    waitForThread();
+
+    // Смена уровня — пока ни один поток поиска не работает
+    if (player.config().difficulty != snapshot.getBotDifficulty()) {
+        BotConfig config = player.config();
+        config.difficulty = snapshot.getBotDifficulty();
+        player.setConfig(config);
+    }
+
+    const quint64 request = ++requestId;
+    auto flag = std::make_shared<std::atomic<bool>>(false);
+    cancelFlag = flag;
+    thinking = true;
+
+    // Снимок копируется в поток по значению: дальнейшие изменения партии
+    // в GUI-потоке на поиск не влияют
+    thread = QThread::create([this, snapshot, side, flag, request]() {
+        // Потоки поиска идут строго по одному, так что состояние бота без гонок
+        Trace::setThreadName("BotWorker");
+        BotMove move = player.chooseMove(snapshot, side, flag.get());
+        if (!flag->load()) emit searchFinished(move, request);
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
+
+void BotWorker::cancel()
+{
+    if (cancelFlag) cancelFlag->store(true);
+    cancelFlag.reset();
+    thinking = false;
+}
+
+void BotWorker::waitForThread()
+{
+    if (thread) thread->wait();
+}
+
+void BotWorker::onSearchFinished(const BotMove &move, quint64 request)
+{
+    // Результат устаревшего или отменённого поиска игнорируем
+    if (request != requestId || !thinking) return;
+    thinking = false;
+    emit moveReady(move);
+}
@@ -0,0 +1,54 @@
+#ifndef BOTWORKER_H
+#define BOTWORKER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include "gamelogic.h"
+#include "botplayer.h"
+
+Q_DECLARE_METATYPE(BotMove)
+
+// Поиск хода бота (BotPlayer) в отдельном потоке. Поток получает собственную копию
+// партии (снимок) и не трогает живую GameLogic; результат публикуется
+// сигналом moveReady, который доходит до GUI-потока через очередь событий.
+class BotWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BotWorker(QObject *parent = nullptr);
+    ~BotWorker() override;
+
+    // Запускает поиск хода за сторону side по снимку партии (уровень — из
+    // снимка). Незавершённый предыдущий поиск отменяется. Сила в moveReady
+    // уже с множителем сложности.
+    void start(const GameLogic &snapshot, Side side);
+
+    // Отменяет текущий поиск; его результат не будет опубликован
+    void cancel();
+
+    bool isThinking() const { return thinking; }
+
+
+signals:
+    void moveReady(const BotMove &move);
+    // Внутренний: испускается из потока поиска
+    void searchFinished(const BotMove &move, quint64 request);
+
+private slots:
+    void onSearchFinished(const BotMove &move, quint64 request);
+
+private:
+    BotPlayer player; // деревья и кэш живут между ходами; трогает только поток поиска
+    QPointer<QThread> thread;
+    std::shared_ptr<std::atomic<bool>> cancelFlag;
+    quint64 requestId;
+    bool thinking;
+
+    void waitForThread();
+};
+
+#endif // BOTWORKER_H
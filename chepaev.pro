@@ -0,0 +1,19 @@
+# Общий проект: ядро, приложение и консольные утилиты
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    core \
+    app \
+    bench \
+    bookgen \
+    tournament \
+    trainer
+
+app.file = untitled.pro
+app.makefile = Makefile.app
+app.depends = core
+
+bench.depends = core
+bookgen.depends = core
+tournament.depends = core
+trainer.depends = core
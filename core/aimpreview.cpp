@@ -0,0 +1,71 @@
+#include "aimpreview.h"
+#include <QElapsedTimer>
+#include <utility>
+
+AimPreview::AimPreview()
+    : pendingChecker(-1), hasPending(false),
+    sim(BoardGeometry{ 0.0f, 0.0f, 1.0f, 8 }), workEvents(0), working(false)
+{
+}
+
+void AimPreview::request(const BoardSnapshot &board, int checker, const QPointF &force)
+{
+    // Тот же удар уже считается или посчитан
+    const Outcome &latest = working ? work : ready;
+    if ((working || ready.valid) && !hasPending && latest.checker == checker && latest.force == force) return;
+
+    pendingBoard = board; // QVector внутри — неявно разделяемые, копия дешёвая
+    pendingChecker = checker;
+    pendingForce = force;
+    hasPending = true;
+}
+
+void AimPreview::clear()
+{
+    hasPending = false;
+    working = false;
+    ready.valid = false;
+}
+
+bool AimPreview::advance(float budgetMs)
+{
+    if (!isBusy()) return false;
+
+    QElapsedTimer clock;
+    clock.start();
+    const qint64 budgetNs = qint64(double(budgetMs) * 1e6);
+
+    // Новый запрос вытесняет незаконченный расчёт
+    if (hasPending) {
+        hasPending = false;
+        working = true;
+        workEvents = 0;
+        sim = AnalyticSimulator(pendingBoard.geometry);
+        work.checker = pendingChecker;
+        work.force = pendingForce;
+        work.start = pendingBoard.pieces;
+        work.end.assign(pendingBoard.pieces);
+        work.paths.resize(work.end.size());
+        for (int i = 0; i < work.end.size(); ++i) {
+            work.paths[i].clear();
+            work.paths[i].push_back(QPointF(work.end.x[i], work.end.y[i]));
+        }
+        if (pendingChecker >= 0 && pendingChecker < work.end.size() && work.end.isAlive(pendingChecker)) {
+            work.end.vx[pendingChecker] = pendingForce.x();
+            work.end.vy[pendingChecker] = pendingForce.y();
+        }
+    }
+
+    // Порции событий, пока не кончится движение или бюджет кадра
+    while (clock.nsecsElapsed() < budgetNs) {
+        const AnalyticSimulator::Result r = sim.run(work.end, EVENTS_PER_CHUNK, &work.paths);
+        workEvents += r.events;
+        if (r.events < EVENTS_PER_CHUNK || workEvents >= MAX_EVENTS) {
+            working = false;
+            work.valid = true;
+            std::swap(ready, work);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,57 @@
+#ifndef AIMPREVIEW_H
+#define AIMPREVIEW_H
+
+#include <QPointF>
+#include <QVector>
+#include "analyticsim.h"
+#include "checkerstore.h"
+
+// Предпросмотр удара при прицеливании: полный розыгрыш AnalyticSimulator для
+// текущего вектора силы с траекториями всех сдвинутых шашек.
+//
+// Рассчитан на поток событий мыши: request только запоминает последний
+// запрос (промежуточные схлопываются), а считает advance — из кадра, не
+// дольше заданного бюджета. Расчёт идёт порциями событий и продолжается в
+// следующем кадре; новый запрос бросает незаконченный старый. Пока новый
+// результат не готов, result() отдаёт последний завершённый.
+class AimPreview
+{
+public:
+    struct Outcome {
+        bool valid = false;
+        int checker = -1;
+        QPointF force;
+        QVector<QVector<QPointF>> paths; // по шашке: старт и точки событий (1 точка — не двигалась)
+        CheckerStore end;                // позиция после остановки
+        CheckerStore start;              // позиция до удара — выбитые шашки
+    };
+
+    AimPreview();
+
+    // Удар checker с силой force в позиции board
+    void request(const BoardSnapshot &board, int checker, const QPointF &force);
+    // Забыть запросы и результат (прицеливание закончилось)
+    void clear();
+    // Продвигает расчёт не дольше budgetMs; true, если готов новый результат
+    bool advance(float budgetMs);
+
+    const Outcome &result() const { return ready; }
+    bool isBusy() const { return hasPending || working; }
+
+private:
+    static constexpr int EVENTS_PER_CHUNK = 8;
+    static constexpr int MAX_EVENTS = 512;
+
+    BoardSnapshot pendingBoard;
+    int pendingChecker;
+    QPointF pendingForce;
+    bool hasPending;
+
+    AnalyticSimulator sim;
+    Outcome work;     // считается сейчас
+    int workEvents;
+    bool working;
+    Outcome ready;    // последний завершённый
+};
+
+#endif // AIMPREVIEW_H
@@ -0,0 +1,192 @@
+#include "analyticsim.h"
+#include "gamelogic.h"
+#include <cmath>
+#include <limits>
+
+AnalyticSimulator::AnalyticSimulator(const BoardGeometry &geometry)
+    : geom(geometry), radius(geometry.checkerRadius())
+{
+    // Та же модель, что у пошагового интегратора: x(t) = x0 + v0 * A * (1 - e^{-kt}),
+    // v(t) = v0 * e^{-kt}, A = 1/k. Без столкновений результат совпадает при любом шаге.
+    decayRate = Physics::decayRate();
+    travelScale = 1.0 / decayRate;
+}
+
+// Время, за которое шашка со скоростью 1 проходит путь s (бесконечность — не дойдёт)
+double AnalyticSimulator::timeForTravel(double s) const
+{
+    if (s >= travelScale) return std::numeric_limits<double>::infinity();
+    return -std::log(1.0 - s / travelScale) / decayRate;
+}
+
+AnalyticSimulator::Result AnalyticSimulator::run(CheckerStore &pieces, int maxEvents,
+                                                QVector<QVector<QPointF>> *paths) const
+{
+    enum EventKind { RestEvent, ContactEvent, ExitEvent };
+
+    Result result = { 0.0f, 0, 0, 0 };
+    const int n = pieces.size();
+    const double diameter = 2.0 * radius;
+    const double diameter2 = diameter * diameter;
+    const double rest2 = double(Physics::REST_SPEED) * Physics::REST_SPEED;
+    float *xs = pieces.x.data();
+    float *ys = pieces.y.data();
+    float *vxs = pieces.vx.data();
+    float *vys = pieces.vy.data();
+
+    // Границы, за которыми центр шашки означает вылет
+    const double minX = geom.left - radius;
+    const double maxX = geom.left + geom.size + radius;
+    const double minY = geom.top - radius;
+    const double maxY = geom.top + geom.size + radius;
+
+    double time = 0.0;
+    while (result.events < maxEvents) {
+        // Момент остановки самой быстрой шашки — конец удара, если раньше ничего не случится
+        double maxSpeed2 = 0.0;
+        for (int i = 0; i < n; ++i) {
+            if (!pieces.isAlive(i)) continue;
+            maxSpeed2 = qMax(maxSpeed2, double(vxs[i]) * vxs[i] + double(vys[i]) * vys[i]);
+        }
+        if (maxSpeed2 <= rest2) break;
+
+        double eventTime = 0.5 * std::log(maxSpeed2 / rest2) / decayRate;
+        EventKind kind = RestEvent;
+        int first = -1;
+        int second = -1;
+
+        // Ближайшее касание: |d + w*s| = 2r относительно общего пути s
+        for (int i = 0; i < n; ++i) {
+            if (!pieces.isAlive(i)) continue;
+            for (int j = i + 1; j < n; ++j) {
+                if (!pieces.isAlive(j)) continue;
+
+                const double wx = double(vxs[j]) - vxs[i];
+                const double wy = double(vys[j]) - vys[i];
+                const double dx = double(xs[j]) - xs[i];
+                const double dy = double(ys[j]) - ys[i];
+                const double b = dx * wx + dy * wy;
+                if (b >= 0.0) continue; // не сближаются
+
+                const double c = dx * dx + dy * dy - diameter2;
+                double s = 0.0;
+                if (c > 0.0) {
+                    const double a = wx * wx + wy * wy;
+                    const double disc = b * b - a * c;
+                    if (disc < 0.0) continue; // проходят мимо
+                    s = (-b - std::sqrt(disc)) / a;
+                }
+
+                const double t = timeForTravel(s);
+                if (t < eventTime) {
+                    eventTime = t;
+                    kind = ContactEvent;
+                    first = i;
+                    second = j;
+                }
+            }
+        }
+
+        // Ближайший вылет за доску (движение по прямой, путь s до границы)
+        for (int i = 0; i < n; ++i) {
+            if (!pieces.isAlive(i)) continue;
+            double s = std::numeric_limits<double>::infinity();
+            if (vxs[i] < 0.0f) s = qMin(s, (minX - xs[i]) / vxs[i]);
+            if (vxs[i] > 0.0f) s = qMin(s, (maxX - xs[i]) / vxs[i]);
+            if (vys[i] < 0.0f) s = qMin(s, (minY - ys[i]) / vys[i]);
+            if (vys[i] > 0.0f) s = qMin(s, (maxY - ys[i]) / vys[i]);
+
+            const double t = timeForTravel(qMax(s, 0.0));
+            if (t < eventTime) {
+                eventTime = t;
+                kind = ExitEvent;
+                first = i;
+            }
+        }
+
+        // Переносим все шашки в момент события одной формулой
+        const double decay = std::exp(-decayRate * eventTime);
+        const double travel = travelScale * (1.0 - decay);
+        for (int i = 0; i < n; ++i) {
+            if (!pieces.isAlive(i)) continue;
+            const bool moving = vxs[i] != 0.0f || vys[i] != 0.0f;
+            xs[i] += static_cast<float>(vxs[i] * travel);
+            ys[i] += static_cast<float>(vys[i] * travel);
+            vxs[i] *= static_cast<float>(decay);
+            vys[i] *= static_cast<float>(decay);
+            if (paths && moving) (*paths)[i].push_back(QPointF(xs[i], ys[i]));
+        }
+        time += eventTime;
+        result.events++;
+
+        if (kind == RestEvent) break;
+
+        if (kind == ExitEvent) {
+            pieces.kill(first);
+            result.exits++;
+            continue;
+        }
+
+        // Удар — по той же модели, что в GameLogic::handleCollisions
+        const float dx = xs[second] - xs[first];
+        const float dy = ys[second] - ys[first];
+        const float dist = std::sqrt(dx * dx + dy * dy);
+        if (dist <= 0.0f) continue;
+        const float nx = dx / dist;
+        const float ny = dy / dist;
+        Physics::collide(vxs, vys, first, second, nx, ny);
+        result.contacts++;
+    }
+
+    result.time = static_cast<float>(time);
+    return result;
+}
+
+AnalyticSimulator::Result AnalyticSimulator::simulateShot(CheckerStore &pieces, int checker,
+                                                          const QPointF &force) const
+{
+    if (checker >= 0 && checker < pieces.size() && pieces.isAlive(checker)) {
+        pieces.vx[checker] = force.x();
+        pieces.vy[checker] = force.y();
+    }
+    return run(pieces);
+}
+
+AnalyticSimulator::Validation AnalyticSimulator::validate(const GameLogic &logic, int checker,
+                                                          const QPointF &force, float step)
+{
+    Validation v = { 0.0f, 0.0f, 0, 0, { 0.0f, 0, 0, 0 } };
+
+    // Пошаговый интегратор на копии партии — до остановки, как в игре
+    GameLogic stepped = logic;
+    stepped.shoot(checker, force);
+    const int MAX_STEPS = 100000;
+    do {
+        stepped.update(step);
+        v.steps++;
+    } while (stepped.isMoving() && v.steps < MAX_STEPS);
+
+    CheckerStore pieces = logic.checkerStore();
+    AnalyticSimulator sim(logic.geometry());
+    v.analytic = sim.simulateShot(pieces, checker, force);
+
+    int compared = 0;
+    double errorSum = 0.0;
+    for (int i = 0; i < pieces.size(); ++i) {
+        const bool aliveA = pieces.isAlive(i);
+        const bool aliveS = stepped.isCheckerAlive(i);
+        if (aliveA != aliveS) {
+            v.aliveMismatch++;
+            continue;
+        }
+        if (!aliveA) continue;
+
+        const QPointF ps = stepped.getCheckerPosition(i);
+        const float err = std::hypot(pieces.x[i] - float(ps.x()), pieces.y[i] - float(ps.y()));
+        v.maxError = qMax(v.maxError, err);
+        errorSum += err;
+        compared++;
+    }
+    v.meanError = compared > 0 ? static_cast<float>(errorSum / compared) : 0.0f;
+    return v;
+}
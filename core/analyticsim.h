@@ -0,0 +1,62 @@
+#ifndef ANALYTICSIM_H
+#define ANALYTICSIM_H
+
+#include <QPointF>
+#include "checkerstore.h"
+#include "physics.h"
+
+class GameLogic;
+
+// Событийный симулятор удара в замкнутой форме.
+//
+// Между столкновениями скорость каждой шашки затухает по одному и тому же
+// закону Physics: v(t) = v0 * e^{-kt}, поэтому смещение за время t равно
+// v0 * s(t), где s(t) = A * (1 - e^{-kt}) — общий для всех шашек "путь на
+// единицу скорости". Относительное движение пары линейно по s,
+// и момент касания, вылета за край или остановки находится решением уравнения,
+// а не перебором кадров. Весь удар разыгрывается за несколько десятков событий.
+class AnalyticSimulator
+{
+public:
+    struct Result {
+        float time;    // время до остановки всех шашек, сек
+        int events;    // сколько событий обработано
+        int contacts;  // столкновений
+        int exits;     // вылетов за доску
+    };
+
+    // Сравнение с пошаговым интегратором GameLogic::update
+    struct Validation {
+        float maxError;     // наибольшее расхождение позиций живых шашек, px
+        float meanError;    // среднее расхождение, px
+        int aliveMismatch;  // шашек, выбитых только одним из движков
+        int steps;          // шагов пошагового интегратора
+        Result analytic;
+    };
+
+    explicit AnalyticSimulator(const BoardGeometry &geometry);
+
+    // Разыгрывает движение до остановки; pieces изменяются на месте. Если
+    // events == maxEvents, движение не закончено и run можно вызвать снова.
+    // paths (по строке на шашку) дополняется точками событий: между ними шашки
+    // движутся по прямой, так что это точные траектории.
+    Result run(CheckerStore &pieces, int maxEvents = 512, QVector<QVector<QPointF>> *paths = nullptr) const;
+
+    // Удар шашкой checker с силой force из текущей позиции logic
+    Result simulateShot(CheckerStore &pieces, int checker, const QPointF &force) const;
+
+    // Режим проверки: один и тот же удар разыгрывается обоими движками,
+    // пошаговым — с шагом step
+    static Validation validate(const GameLogic &logic, int checker, const QPointF &force,
+                               float step = Physics::STEP);
+
+private:
+    BoardGeometry geom;
+    float radius;
+    double decayRate;   // k: e^{-kt} — затухание скорости за время t
+    double travelScale; // A: полный путь шашки со скоростью 1 до остановки
+
+    double timeForTravel(double s) const;
+};
+
+#endif // ANALYTICSIM_H
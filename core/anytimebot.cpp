@@ -0,0 +1,188 @@
+#include "anytimebot.h"
+#include "analyticsim.h"
+#include "evaluator.h"
+#include "shotcache.h"
+#include "trace.h"
+#include "workpool.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const int BASE_WIDTH = 4;               // эвристических кандидатов в первой итерации
+const int MAX_WIDTH = 256;
+const int EVALUATIONS_PER_CANDIDATE = 40;
+const float BOOST = 1.35f;              // вторая сила кандидата
+const float MAX_FORCE = 540.0f;
+const int REFINE_SEEDS = 6;             // лучших ударов, вокруг которых идёт уточнение
+const int REFINE_VARIANTS = 8;          // вариантов на каждый за итерацию
+const float REFINE_ANGLE_DEG = 6.0f;    // начальный разброс уточнения
+const float REFINE_POWER = 0.15f;
+const float REFINE_DECAY = 0.7f;        // сужение разброса за итерацию
+const float REFINE_MIN_SPREAD = 0.05f;  // доля начального разброса, ниже которой не сужаем
+const int EVAL_BATCH = LearnedEvaluator::BLOCK; // кандидатов на одну пакетную оценку
+
+struct Candidate {
+    BotMove move;
+    float value;
+    bool done;
+};
+
+bool sameMove(const BotMove &a, const BotMove &b)
+{
+    return a.checkerIndex == b.checkerIndex && a.force == b.force;
+}
+
+// Удар с силой, повёрнутой на angleDeg и умноженной на scale (не сильнее MAX_FORCE)
+BotMove varied(const BotMove &m, float angleDeg, float scale)
+{
+    const float power = std::hypot(float(m.force.x()), float(m.force.y()));
+    if (power * scale > MAX_FORCE) scale = MAX_FORCE / power;
+    const float a = angleDeg * 3.14159265f / 180.0f;
+    const float c = std::cos(a) * scale;
+    const float s = std::sin(a) * scale;
+    BotMove out = m;
+    out.force = QPointF(m.force.x() * c - m.force.y() * s, m.force.x() * s + m.force.y() * c);
+    return out;
+}
+
+} // namespace
+
+AnytimeBot::AnytimeBot(WorkPool *pool_)
+    : pool(pool_ ? pool_ : &WorkPool::shared()), shotCache(nullptr), leafEvaluator(nullptr), stats()
+{
+}
+
+BotMove AnytimeBot::search(const GameLogic &game, Side side, const BotLimits &limits,
+                           const std::atomic<bool> *cancel)
+{
+    TRACE_ZONE("AnytimeBot::search");
+    stats = Stats();
+    const BotMove none = { -1, QPointF(0, 0), -1000 };
+    QElapsedTimer clock;
+    clock.start();
+    const qint64 budgetNs = qint64(double(limits.budgetMs) * 1e6);
+    auto cancelled = [cancel] { return cancel && cancel->load(std::memory_order_relaxed); };
+    auto stopped = [&] { return cancelled() || clock.nsecsElapsed() >= budgetNs; };
+
+    // Глубина 0: эвристика — с этого момента ход есть всегда
+    BotMove best = game.searchShot(side, limits.evaluations, cancel);
+    if (cancelled()) return none;
+    if (best.checkerIndex < 0 || limits.maxDepth <= 0) {
+        stats.elapsedMs = clock.nsecsElapsed() / 1e6f;
+        return best;
+    }
+
+    static const MaterialEvaluator material;
+    const PositionEvaluator &evaluator = leafEvaluator ? *leafEvaluator : material;
+    const BoardSnapshot root = game.snapshot();
+    const BoardGeometry &geometry = root.geometry;
+    const AnalyticSimulator sim(geometry);
+    const quint64 rootHash = BoardHash::compute(root.pieces, geometry);
+    const Side enemy = opponentOf(side);
+    // Удар сыграют с множителем силы уровня — с ним его и разыгрываем
+    const float forceScale = GameLogic::botSpeedMultiplier(game.getBotDifficulty());
+    // По EVAL_BATCH позиций на рабочего: куску кандидатов одна оценка на всех
+    std::vector<CheckerStore> scratch(size_t(pool->workerCount()) * EVAL_BATCH);
+    std::atomic<int> shots(0);
+    // Разброс уточнения воспроизводим для позиции
+    QRandomGenerator rng(quint32(rootHash ^ (rootHash >> 32)));
+
+    // Позиция после удара; ценность для side считается потом пачкой, ходит соперник
+    auto play = [&](CheckerStore &after, const BotMove &m) {
+        after.assign(root.pieces);
+        const QPointF force = m.force * forceScale;
+        if (shotCache) shotCache->simulateShot(sim, after, rootHash, m.checkerIndex, force);
+        else sim.simulateShot(after, m.checkerIndex, force);
+        shots.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    int depth = 1;
+    int width = BASE_WIDTH;
+    float spread = 1.0f;
+    std::vector<BotMove> seeds; // лучшие удары прошлой итерации
+    while (!stopped()) {
+        // Прежний лучший ход — первым
+        std::vector<Candidate> candidates;
+        candidates.push_back({ best, 0.0f, false });
+        auto add = [&](const BotMove &m) {
+            if (!sameMove(m, best)) candidates.push_back({ m, 0.0f, false });
+        };
+        QVector<BotMove> heuristic;
+        if (depth == 1) {
+            // Лучшие удары эвристики с обычной и увеличенной силой
+            heuristic = game.searchCandidates(
+                side, qMax(limits.evaluations, width * EVALUATIONS_PER_CANDIDATE), width, cancel);
+            if (cancelled()) return none;
+            for (const BotMove &h : heuristic) {
+                add(h);
+                add(varied(h, 0.0f, BOOST));
+            }
+        } else {
+            // Уточнение: случайные соседи лучших ударов по углу и силе
+            for (const BotMove &s : seeds) {
+                for (int v = 0; v < REFINE_VARIANTS; ++v) {
+                    const float da = float(rng.generateDouble() * 2.0 - 1.0) * REFINE_ANGLE_DEG * spread;
+                    const float ds = float(rng.generateDouble() * 2.0 - 1.0) * REFINE_POWER * spread;
+                    add(varied(s, da, 1.0f + ds));
+                }
+            }
+        }
+
+        // Куски не больше EVAL_BATCH, но так, чтобы хватило всем рабочим
+        Candidate *items = candidates.data();
+        const int count = int(candidates.size());
+        const int grain = qBound(1, count / pool->workerCount(), EVAL_BATCH);
+        pool->parallelFor(count, grain, [&](int begin, int end, int worker) {
+            CheckerStore *after = &scratch[size_t(worker) * EVAL_BATCH];
+            const CheckerStore *positions[EVAL_BATCH];
+            Side toMove[EVAL_BATCH];
+            float values[EVAL_BATCH];
+            int n = 0;
+            for (int k = begin; k < end && !stopped(); ++k, ++n) {
+                play(after[n], items[k].move);
+                positions[n] = &after[n];
+                toMove[n] = enemy;
+            }
+            if (n == 0) return;
+            evaluator.evaluateBatch(positions, toMove, n, geometry, side, values);
+            for (int p = 0; p < n; ++p) {
+                items[begin + p].value = values[p];
+                items[begin + p].done = true;
+            }
+        });
+        if (cancelled()) return none;
+
+        // Незавершённая итерация учитывается, только если в ней есть оценка прежнего хода
+        bool complete = true;
+        for (const Candidate &c : candidates) complete = complete && c.done;
+        if (candidates[0].done) {
+            std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+                return a.done && (!b.done || a.value > b.value);
+            });
+            best = candidates[0].move;
+            best.score = candidates[0].value;
+            stats.depth = depth;
+            stats.width = width;
+            seeds.clear();
+            for (const Candidate &c : candidates) {
+                if (!c.done || int(seeds.size()) >= REFINE_SEEDS) break;
+                seeds.push_back(c.move);
+            }
+        }
+        if (!complete) break;
+        stats.iterations++;
+
+        if (depth == 1 && width < MAX_WIDTH && heuristic.size() >= width) width *= 2;
+        else if (depth < limits.maxDepth) depth = 2;
+        else if (depth == 2) spread = qMax(REFINE_MIN_SPREAD, spread * REFINE_DECAY);
+        else break; // перебрали всё, что даёт эвристика, — раньше срока
+    }
+
+    stats.shots = shots.load();
+    stats.elapsedMs = clock.nsecsElapsed() / 1e6f;
+    return best;
+}
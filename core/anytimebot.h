@@ -0,0 +1,64 @@
+#ifndef ANYTIMEBOT_H
+#define ANYTIMEBOT_H
+
+#include <atomic>
+#include "checkerstore.h"
+#include "gamelogic.h"
+
+class PositionEvaluator;
+class ShotCache;
+class WorkPool;
+
+// Поиск удара "в любой момент" для уровней Easy, Medium и Hard: лучший ход
+// есть с первых долей миллисекунды, а до истечения BotLimits::budgetMs поиск
+// углубляется и уточняется.
+//
+//   глубина 0 — эвристический поиск по evaluateMove (searchShot);
+//   глубина 1 — лучшие кандидаты эвристики (и они же с силой BOOST)
+//               разыгрываются AnalyticSimulator до остановки (с множителем
+//               силы уровня, как их сыграет BotPlayer), позиция
+//               оценивается PositionEvaluator; список кандидатов
+//               удваивается, пока эвристика даёт новые удары;
+//   глубина 2 — уточнение: случайные соседи лучших ударов по углу и силе
+//               с сужающимся разбросом, пока не кончится время.
+//
+// Ход берётся из последней завершённой итерации. В незавершённой первым
+// считается прежний лучший ход — если другой кандидат той же итерации его
+// обошёл, берётся он. Кандидаты итерации считаются параллельно на пуле,
+// кусками до LearnedEvaluator::BLOCK ударов с одной пакетной оценкой на кусок.
+class AnytimeBot
+{
+public:
+    struct Stats {
+        int depth;        // глубина последней учтённой итерации
+        int width;        // эвристических кандидатов на глубине 1
+        int iterations;   // завершённых итераций
+        int shots;        // ударов, разыгранных симулятором
+        float elapsedMs;
+    };
+
+    explicit AnytimeBot(WorkPool *pool = nullptr); // nullptr — общий пул
+
+    AnytimeBot(const AnytimeBot &) = delete;
+    AnytimeBot &operator=(const AnytimeBot &) = delete;
+
+    // Общий кэш исходов ударов (nullptr — без кэша)
+    void setShotCache(ShotCache *cache) { shotCache = cache; }
+    // Оценка позиций после ударов (nullptr — MaterialEvaluator)
+    void setEvaluator(const PositionEvaluator *evaluator) { leafEvaluator = evaluator; }
+
+    // Ход за side в позиции game не позже limits.budgetMs. При взводе cancel
+    // возвращается ход с checkerIndex = -1.
+    BotMove search(const GameLogic &game, Side side, const BotLimits &limits,
+                   const std::atomic<bool> *cancel = nullptr);
+
+    const Stats &lastStats() const { return stats; }
+
+private:
+    WorkPool *pool;
+    ShotCache *shotCache;
+    const PositionEvaluator *leafEvaluator;
+    Stats stats;
+};
+
+#endif // ANYTIMEBOT_H
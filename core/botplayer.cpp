@@ -0,0 +1,133 @@
+#include "botplayer.h"
+#include "anytimebot.h"
+#include "mctsbot.h"
+#include "openingbook.h"
+#include "logger.h"
+#include "shotcache.h"
+#include "trace.h"
+#include "workpool.h"
+#include <QElapsedTimer>
+
+bool BotConfig::parse(const QString &spec, BotConfig &config)
+{
+    const QString s = spec.toLower();
+    const int colon = s.indexOf(':');
+    const QString level = colon < 0 ? s : s.left(colon);
+    if (level == "easy") config.difficulty = Easy;
+    else if (level == "medium") config.difficulty = Medium;
+    else if (level == "hard") config.difficulty = Hard;
+    else if (level == "master") config.difficulty = Master;
+    else return false;
+
+    config.budgetMs = 0.0f;
+    if (colon >= 0) {
+        bool ok = false;
+        const float ms = s.mid(colon + 1).toFloat(&ok);
+        if (!ok || ms <= 0.0f) return false;
+        config.budgetMs = ms;
+    }
+    return true;
+}
+
+QString BotConfig::name() const
+{
+    QString level = "?";
+    switch (difficulty) {
+    case Easy:   level = "easy"; break;
+    case Medium: level = "medium"; break;
+    case Hard:   level = "hard"; break;
+    case Master: level = "master"; break;
+    }
+    return budgetMs > 0.0f ? QString("%1:%2").arg(level).arg(double(budgetMs)) : level;
+}
+
+BotLimits BotConfig::limits() const
+{
+    BotLimits l = GameLogic::botLimits(difficulty);
+    if (budgetMs > 0.0f) l.budgetMs = budgetMs;
+    if (threads >= 0) l.threads = threads;
+    return l;
+}
+
+BotPlayer::BotPlayer(const BotConfig &config, quint32 seed)
+    : rng(seed), openingBook(nullptr), leafEvaluator(nullptr), totalThinkNs(0), moveCount(0), totalSearchShots(0)
+{
+    setConfig(config);
+}
+
+BotPlayer::~BotPlayer() = default;
+
+void BotPlayer::setConfig(const BotConfig &config)
+{
+    cfg = config;
+    const BotLimits limits = cfg.limits();
+    mcts.reset();
+    anytime.reset();
+    pool.reset();
+
+    if (limits.threads > 0) pool.reset(new WorkPool(limits.threads));
+    if (!cache) cache.reset(new ShotCache);
+    if (cfg.difficulty != Master) {
+        anytime.reset(new AnytimeBot(pool.get()));
+        anytime->setShotCache(cache.get());
+        anytime->setEvaluator(leafEvaluator);
+        return;
+    }
+
+    mcts.reset(new MctsBot(pool.get()));
+    MctsConfig mc;
+    mc.budgetMs = limits.budgetMs;
+    mc.threads = limits.threads;
+    mc.seed = rng.generate();
+    mc.forceScale = GameLogic::botSpeedMultiplier(cfg.difficulty);
+    mcts->setConfig(mc);
+    mcts->setShotCache(cache.get());
+    mcts->setEvaluator(leafEvaluator);
+}
+
+void BotPlayer::setEvaluator(const PositionEvaluator *evaluator)
+{
+    leafEvaluator = evaluator;
+    if (mcts) mcts->setEvaluator(evaluator);
+    if (anytime) anytime->setEvaluator(evaluator);
+}
+
+void BotPlayer::newGame()
+{
+    if (mcts) mcts->reset();
+}
+
+BotMove BotPlayer::chooseMove(const GameLogic &game, Side side, const std::atomic<bool> *cancel)
+{
+    TRACE_ZONE("BotPlayer::chooseMove");
+    QElapsedTimer timer;
+    timer.start();
+
+    GameLogic view = game;
+    view.setBotDifficulty(cfg.difficulty);
+
+    // Книжный удар найден глубоким поиском ровно с этой силой — без множителя
+    BotMove move;
+    const bool fromBook = cfg.useBook && openingBook && cfg.difficulty >= Hard
+                          && openingBook->lookup(view.snapshot(), side, move);
+    if (fromBook) {
+        logDebug(lcBot) << "Ход из дебютной книги: шашка" << move.checkerIndex << "сила:" << move.force;
+    } else {
+        if (mcts) {
+            move = mcts->search(view.snapshot(), side, cancel);
+            totalSearchShots += mcts->lastStats().shots;
+        } else {
+            move = anytime->search(view, side, cfg.limits(), cancel);
+            totalSearchShots += anytime->lastStats().shots;
+        }
+        if (cancel && cancel->load()) return {-1, QPointF(0, 0), -1000};
+
+        // fallback (если поиск не дал результата)
+        if (move.checkerIndex < 0) move = view.fallbackMove(side, rng);
+        if (move.checkerIndex >= 0) move.force *= GameLogic::botSpeedMultiplier(cfg.difficulty);
+    }
+
+    totalThinkNs += timer.nsecsElapsed();
+    moveCount++;
+    return move;
+}
@@ -0,0 +1,77 @@
+#ifndef BOTPLAYER_H
+#define BOTPLAYER_H
+
+#include <QRandomGenerator>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include "gamelogic.h"
+
+class AnytimeBot;
+class MctsBot;
+class OpeningBook;
+class PositionEvaluator;
+class ShotCache;
+class WorkPool;
+
+// Настройки бота-игрока
+struct BotConfig {
+    BotDifficulty difficulty = Medium;
+    float budgetMs = 0.0f;    // время на ход; 0 — по уровню (GameLogic::botLimits)
+    int threads = -1;         // -1 — по уровню, 0 — общий пул, иначе свой пул на столько потоков
+    bool useBook = true;      // дебютная книга (на уровнях Hard и Master)
+
+    // "easy", "medium", "hard", "master", к любому можно ":<мс на ход>"
+    static bool parse(const QString &spec, BotConfig &config);
+    QString name() const;
+    // Ограничения уровня с учётом заданных здесь времени и потоков
+    BotLimits limits() const;
+};
+
+// Бот целиком, как он играет в окне: книга -> поиск (AnytimeBot или MCTS)
+// -> запасной ход с шумом -> множитель силы по сложности. Один и тот же
+// конвейер используют GameWidget (через BotWorker) и консольный турнир.
+// Случайность только из собственного генератора с заданным зерном, поэтому
+// партия ботов воспроизводима.
+class BotPlayer
+{
+public:
+    explicit BotPlayer(const BotConfig &config = BotConfig(), quint32 seed = 1);
+    ~BotPlayer();
+
+    BotPlayer(const BotPlayer &) = delete;
+    BotPlayer &operator=(const BotPlayer &) = delete;
+
+    void setConfig(const BotConfig &config);
+    const BotConfig &config() const { return cfg; }
+    void setOpeningBook(const OpeningBook *book) { openingBook = book; }
+    // Оценка позиций в поиске (nullptr — материальная)
+    void setEvaluator(const PositionEvaluator *evaluator);
+
+    // Удар за сторону side в позиции game (сила уже с множителем сложности).
+    // При отмене — ход с checkerIndex = -1.
+    BotMove chooseMove(const GameLogic &game, Side side, const std::atomic<bool> *cancel = nullptr);
+
+    // Новая партия: сохранённые деревья поиска больше не нужны
+    void newGame();
+
+    // Накопленная статистика
+    qint64 thinkNs() const { return totalThinkNs; }
+    int moves() const { return moveCount; }
+    qint64 searchShots() const { return totalSearchShots; } // ударов, разыгранных поиском
+
+private:
+    BotConfig cfg;
+    QRandomGenerator rng;
+    const OpeningBook *openingBook;
+    const PositionEvaluator *leafEvaluator;
+    std::unique_ptr<WorkPool> pool;   // свой пул, если потоков задано больше нуля
+    std::unique_ptr<ShotCache> cache;
+    std::unique_ptr<MctsBot> mcts;        // уровень Master
+    std::unique_ptr<AnytimeBot> anytime;  // остальные уровни
+    qint64 totalThinkNs;
+    int moveCount;
+    qint64 totalSearchShots;
+};
+
+#endif // BOTPLAYER_H
@@ -0,0 +1,144 @@
+#ifndef CHECKERSTORE_H
+#define CHECKERSTORE_H
+
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+
+// Сторона шашки — компактное перечисление вместо сравнения QColor
+enum class Side : quint8 {
+    White = 0,
+    Black = 1
+};
+
+inline Side opponentOf(Side s) { return s == Side::White ? Side::Black : Side::White; }
+
+// Хранилище шашек в виде структуры массивов (SoA): координаты и скорости лежат
+// в плотных массивах float, а признак "в игре" — в битовой маске.
+// Индекс шашки стабилен на всё время партии (выбитые шашки не удаляются).
+struct CheckerStore
+{
+    QVector<float> x;
+    QVector<float> y;
+    QVector<float> vx;
+    QVector<float> vy;
+    QVector<Side> side;
+    QVector<quint64> aliveBits; // бит i == 1 — шашка i в игре
+
+    int size() const { return static_cast<int>(x.size()); }
+
+    void clear()
+    {
+        x.clear(); y.clear(); vx.clear(); vy.clear();
+        side.clear(); aliveBits.clear();
+    }
+
+    void reserve(int n)
+    {
+        x.reserve(n); y.reserve(n); vx.reserve(n); vy.reserve(n);
+        side.reserve(n); aliveBits.reserve((n + 63) / 64);
+    }
+
+    // Добавляет живую неподвижную шашку, возвращает её индекс
+    int add(float px, float py, Side s)
+    {
+        const int i = size();
+        x.push_back(px); y.push_back(py);
+        vx.push_back(0.0f); vy.push_back(0.0f);
+        side.push_back(s);
+        if ((i >> 6) >= aliveBits.size()) aliveBits.push_back(0);
+        aliveBits[i >> 6] |= (quint64(1) << (i & 63));
+        return i;
+    }
+
+    // Копирует состояние src в уже выделенные буферы (без перевыделения памяти,
+    // если ёмкости хватает) — для рабочих копий в поиске и пакетной симуляции
+    void assign(const CheckerStore &src)
+    {
+        x.resize(src.size()); y.resize(src.size());
+        vx.resize(src.size()); vy.resize(src.size());
+        side.resize(src.size()); aliveBits.resize(src.aliveBits.size());
+        std::copy(src.x.cbegin(), src.x.cend(), x.begin());
+        std::copy(src.y.cbegin(), src.y.cend(), y.begin());
+        std::copy(src.vx.cbegin(), src.vx.cend(), vx.begin());
+        std::copy(src.vy.cbegin(), src.vy.cend(), vy.begin());
+        std::copy(src.side.cbegin(), src.side.cend(), side.begin());
+        std::copy(src.aliveBits.cbegin(), src.aliveBits.cend(), aliveBits.begin());
+    }
+
+    bool isAlive(int i) const { return (aliveBits[i >> 6] >> (i & 63)) & 1u; }
+
+    int aliveCount(Side s) const
+    {
+        int count = 0;
+        for (int i = 0; i < size(); ++i) {
+            if (side[i] == s && isAlive(i)) count++;
+        }
+        return count;
+    }
+
+    void kill(int i)
+    {
+        aliveBits[i >> 6] &= ~(quint64(1) << (i & 63));
+        vx[i] = 0.0f;
+        vy[i] = 0.0f;
+    }
+};
+
+// Геометрия доски в пикселях окна
+struct BoardGeometry
+{
+    float left;
+    float top;
+    float size;
+    int cells; // клеток на сторону
+
+    float cellSize() const { return size / cells; }
+    float checkerRadius() const { return cellSize() * 0.4f; }
+
+    // Шашка полностью покинула игровое поле (центр +/− радиус за пределами границ)
+    bool isOffBoard(float x, float y, float radius) const
+    {
+        return (x + radius) < left
+            || (x - radius) > (left + size)
+            || (y + radius) < top
+            || (y - radius) > (top + size);
+    }
+};
+
+// Снимок партии: доска и шашки. Самодостаточен — по нему можно считать
+// в другом потоке, не трогая живую GameLogic.
+struct BoardSnapshot
+{
+    BoardGeometry geometry;
+    CheckerStore pieces;
+};
+
+// Лёгкое представление хранилища только для чтения (указатели + количество).
+// Действительно, пока GameLogic не меняет состав шашек (initBoard).
+struct CheckersView
+{
+    const float *x;
+    const float *y;
+    const float *vx;
+    const float *vy;
+    const Side *side;
+    const quint64 *aliveBits;
+    int count;
+
+    explicit CheckersView(const CheckerStore &s)
+        : x(s.x.constData()), y(s.y.constData()),
+        vx(s.vx.constData()), vy(s.vy.constData()),
+        side(s.side.constData()), aliveBits(s.aliveBits.constData()),
+        count(s.size())
+    {
+    }
+
+    int size() const { return count; }
+    bool isAlive(int i) const { return (aliveBits[i >> 6] >> (i & 63)) & 1u; }
+    QPointF pos(int i) const { return QPointF(x[i], y[i]); }
+    QPointF vel(int i) const { return QPointF(vx[i], vy[i]); }
+};
+
+#endif // CHECKERSTORE_H
@@ -0,0 +1,12 @@
+# Подключение статической библиотеки chepaev-core к приложению или утилите
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+CHEPAEV_CORE_OUT = $$shadowed($$PWD)
+win32:CONFIG(release, debug|release): CHEPAEV_CORE_OUT = $$CHEPAEV_CORE_OUT/release
+else:win32:CONFIG(debug, debug|release): CHEPAEV_CORE_OUT = $$CHEPAEV_CORE_OUT/debug
+
+LIBS += -L$$CHEPAEV_CORE_OUT -lchepaev-core
+
+win32:!win32-g++: PRE_TARGETDEPS += $$CHEPAEV_CORE_OUT/chepaev-core.lib
+else: PRE_TARGETDEPS += $$CHEPAEV_CORE_OUT/libchepaev-core.a
@@ -0,0 +1,46 @@
+# chepaev-core: состояние, физика, правила и бот — без QtGui/QtWidgets.
+# Собирается статической библиотекой; приложение, замеры и утилиты
+# подключают её через core.pri.
+TEMPLATE = lib
+CONFIG += staticlib c++17
+QT = core
+
+TARGET = chepaev-core
+
+SOURCES += \
+    gamelogic.cpp \
+    gamestate.cpp \
+    spatialgrid.cpp \
+    analyticsim.cpp \
+    aimpreview.cpp \
+    workpool.cpp \
+    shotbatch.cpp \
+    shotheatmap.cpp \
+    mctsbot.cpp \
+    anytimebot.cpp \
+    shotcache.cpp \
+    openingbook.cpp \
+    botplayer.cpp \
+    evaluator.cpp \
+    logger.cpp \
+    trace.cpp
+
+HEADERS += \
+    physics.h \
+    gamelogic.h \
+    checkerstore.h \
+    gamestate.h \
+    spatialgrid.h \
+    analyticsim.h \
+    aimpreview.h \
+    workpool.h \
+    shotbatch.h \
+    shotheatmap.h \
+    mctsbot.h \
+    anytimebot.h \
+    shotcache.h \
+    openingbook.h \
+    botplayer.h \
+    evaluator.h \
+    logger.h \
+    trace.h
@@ -0,0 +1,380 @@
+#include "evaluator.h"
+#include "logger.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char MAGIC[4] = { 'C', 'H', 'E', 'V' };
+const int HEADER_SIZE = 20;
+const int MAX_PIECES = EvalFeatures::MAX_PIECES;
+
+// Шашки одной стороны, собранные в плотные массивы
+struct SideView {
+    float x[MAX_PIECES];
+    float y[MAX_PIECES];
+    float margin[MAX_PIECES];
+    int count = 0;
+};
+
+float readFloat(const uchar *p)
+{
+    const quint32 bits = qFromLittleEndian<quint32>(p);
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+void writeFloat(uchar *&p, float f)
+{
+    quint32 bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    qToLittleEndian<quint32>(bits, p);
+    p += 4;
+}
+
+int payloadFloats(LearnedEvaluator::ModelType type)
+{
+    const int F = LearnedEvaluator::FEATURES;
+    const int H = LearnedEvaluator::HIDDEN;
+    return 2 * F + (type == LearnedEvaluator::Linear ? F + 1 : H * F + H + H + 1);
+}
+
+float sigmoid(float z)
+{
+    return 1.0f / (1.0f + std::exp(-z));
+}
+
+} // namespace
+
+float PositionEvaluator::terminalValue(const CheckerStore &pieces, Side perspective)
+{
+    const int own = pieces.aliveCount(perspective);
+    const int enemy = pieces.aliveCount(opponentOf(perspective));
+    if (own == 0 && enemy == 0) return 0.5f;
+    if (enemy == 0) return 1.0f;
+    if (own == 0) return 0.0f;
+    return -1.0f;
+}
+
+void PositionEvaluator::evaluateBatch(const CheckerStore *const *pieces, const Side *toMove, int count,
+                                      const BoardGeometry &geometry, Side perspective, float *out) const
+{
+    for (int k = 0; k < count; ++k) out[k] = evaluate(*pieces[k], geometry, perspective, toMove[k]);
+}
+
+void EvalFeatures::extract(const CheckerStore &pieces, const BoardGeometry &g,
+                           Side perspective, Side toMove, float *out)
+{
+    SideView own;
+    SideView enemy;
+    int ownTotal = 0;
+    const float right = g.left + g.size;
+    const float bottom = g.top + g.size;
+    Q_ASSERT(pieces.size() <= MAX_PIECES);
+    const int n = qMin(pieces.size(), MAX_PIECES);
+    for (int i = 0; i < n; ++i) {
+        const bool mine = pieces.side[i] == perspective;
+        if (mine) ownTotal++;
+        if (!pieces.isAlive(i)) continue;
+        SideView &v = mine ? own : enemy;
+        const float x = pieces.x[i];
+        const float y = pieces.y[i];
+        v.x[v.count] = x;
+        v.y[v.count] = y;
+        v.margin[v.count] = qMin(qMin(x - g.left, right - x), qMin(y - g.top, bottom - y));
+        v.count++;
+    }
+
+    const float perSide = float(qMax(1, ownTotal));
+    const float size = g.size;
+    const float cell = g.cellSize();
+    const float cx = g.left + 0.5f * size;
+    const float cy = g.top + 0.5f * size;
+
+    // Расстояния до края, центр масс и ближайший враг для каждой стороны
+    auto summarize = [&](const SideView &a, const SideView &b, float *meanMargin, float *minMargin,
+                         float *endangered, float *meanGap, float *targets, float *spread) {
+        if (a.count == 0) {
+            *meanMargin = *minMargin = *endangered = *meanGap = *targets = *spread = 0.0f;
+            return;
+        }
+        float sumMargin = 0.0f;
+        float lowest = size;
+        int close = 0;
+        float sx = 0.0f;
+        float sy = 0.0f;
+        float sumGap = 0.0f;
+        int exposed = 0;
+        for (int i = 0; i < a.count; ++i) {
+            sumMargin += a.margin[i];
+            lowest = qMin(lowest, a.margin[i]);
+            if (a.margin[i] < cell) close++;
+            sx += a.x[i];
+            sy += a.y[i];
+            float best = 2.0f * size * 2.0f * size;
+            for (int j = 0; j < b.count; ++j) {
+                const float dx = b.x[j] - a.x[i];
+                const float dy = b.y[j] - a.y[i];
+                best = qMin(best, dx * dx + dy * dy);
+            }
+            const float gap = b.count ? std::sqrt(best) : size;
+            sumGap += gap;
+            // Шашка у края, до которой противнику недалеко — вероятная жертва
+            if (a.margin[i] < 1.5f * cell && gap < 2.5f * cell) exposed++;
+        }
+        const float inv = 1.0f / float(a.count);
+        *meanMargin = sumMargin * inv / size;
+        *minMargin = lowest / size;
+        *endangered = float(close) * inv;
+        *meanGap = sumGap * inv / size;
+        *targets = float(exposed) / perSide;
+        const float dx = sx * inv - cx;
+        const float dy = sy * inv - cy;
+        *spread = std::sqrt(dx * dx + dy * dy) / size;
+    };
+
+    out[MaterialDiff] = float(own.count - enemy.count) / perSide;
+    out[OwnCount] = float(own.count) / perSide;
+    out[EnemyCount] = float(enemy.count) / perSide;
+    summarize(own, enemy, &out[OwnMeanMargin], &out[OwnMinMargin], &out[OwnEndangered],
+              &out[OwnMeanGap], &out[OwnTargets], &out[OwnSpread]);
+    summarize(enemy, own, &out[EnemyMeanMargin], &out[EnemyMinMargin], &out[EnemyEndangered],
+              &out[EnemyMeanGap], &out[EnemyTargets], &out[EnemySpread]);
+    out[ToMove] = toMove == perspective ? 1.0f : 0.0f;
+}
+
+float MaterialEvaluator::evaluate(const CheckerStore &s, const BoardGeometry &g,
+                                  Side perspective, Side toMove) const
+{
+    Q_UNUSED(toMove);
+    int own = 0;
+    int enemy = 0;
+    float marginOwn = 0.0f;
+    float marginEnemy = 0.0f;
+    const float right = g.left + g.size;
+    const float bottom = g.top + g.size;
+    for (int i = 0; i < s.size(); ++i) {
+        if (!s.isAlive(i)) continue;
+        const float margin = qMin(qMin(s.x[i] - g.left, right - s.x[i]),
+                                  qMin(s.y[i] - g.top, bottom - s.y[i]));
+        if (s.side[i] == perspective) { own++; marginOwn += margin; }
+        else { enemy++; marginEnemy += margin; }
+    }
+    if (own == 0 && enemy == 0) return 0.5f;
+    if (enemy == 0) return 1.0f;
+    if (own == 0) return 0.0f;
+
+    const float material = float(own - enemy) / float(own + enemy);
+    const float safety = (marginOwn / own - marginEnemy / enemy) / g.size;
+    return qBound(0.02f, 0.5f + 0.4f * material + 0.1f * safety, 0.98f);
+}
+
+LearnedEvaluator::LearnedEvaluator()
+    : type(Linear), loaded(false), b2(0.0f)
+{
+    std::memset(w1, 0, sizeof(w1));
+    std::memset(b1, 0, sizeof(b1));
+    std::memset(w2, 0, sizeof(w2));
+}
+
+void LearnedEvaluator::setWeights(const Weights &w)
+{
+    // (x - mean) / std * W + b == x * (W / std) + (b - sum(W * mean / std))
+    type = w.type;
+    const int rows = type == Linear ? 1 : HIDDEN;
+    std::memset(w1, 0, sizeof(w1));
+    std::memset(b1, 0, sizeof(b1));
+    std::memset(w2, 0, sizeof(w2));
+    for (int j = 0; j < rows; ++j) {
+        float bias = w.b1[j];
+        for (int i = 0; i < FEATURES; ++i) {
+            const float scale = w.stddev[i] > 1e-6f ? 1.0f / w.stddev[i] : 0.0f;
+            w1[j][i] = w.w1[j][i] * scale;
+            bias -= w.w1[j][i] * scale * w.mean[i];
+        }
+        b1[j] = bias;
+    }
+    if (type == Mlp) std::memcpy(w2, w.w2, sizeof(w2));
+    b2 = type == Mlp ? w.b2 : 0.0f;
+    loaded = true;
+}
+
+bool LearnedEvaluator::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    const QByteArray bytes = file.readAll();
+    const uchar *p = reinterpret_cast<const uchar *>(bytes.constData());
+
+    if (bytes.size() < HEADER_SIZE || std::memcmp(p, MAGIC, 4) != 0
+        || qFromLittleEndian<quint32>(p + 4) != FILE_VERSION) {
+        logWarning(lcData) << "Файл весов оценки повреждён или устарел:" << path;
+        return false;
+    }
+    const quint32 modelType = qFromLittleEndian<quint32>(p + 8);
+    const int features = int(qFromLittleEndian<quint32>(p + 12));
+    const int hidden = int(qFromLittleEndian<quint32>(p + 16));
+    if (modelType > Mlp || features != FEATURES || (modelType == Mlp && hidden != HIDDEN)
+        || bytes.size() < HEADER_SIZE + 4 * payloadFloats(ModelType(modelType))) {
+        logWarning(lcData) << "Файл весов оценки не подходит к этой версии признаков:" << path;
+        return false;
+    }
+
+    Weights w;
+    w.type = ModelType(modelType);
+    p += HEADER_SIZE;
+    auto next = [&p] { const float f = readFloat(p); p += 4; return f; };
+    for (float &v : w.mean) v = next();
+    for (float &v : w.stddev) v = next();
+    if (w.type == Linear) {
+        for (float &v : w.w1[0]) v = next();
+        w.b1[0] = next();
+    } else {
+        for (auto &row : w.w1) for (float &v : row) v = next();
+        for (float &v : w.b1) v = next();
+        for (float &v : w.w2) v = next();
+        w.b2 = next();
+    }
+    setWeights(w);
+    return true;
+}
+
+bool LearnedEvaluator::save(const QString &path, const Weights &w)
+{
+    QByteArray bytes(HEADER_SIZE + 4 * payloadFloats(w.type), '\0');
+    uchar *p = reinterpret_cast<uchar *>(bytes.data());
+    std::memcpy(p, MAGIC, 4);
+    qToLittleEndian<quint32>(FILE_VERSION, p + 4);
+    qToLittleEndian<quint32>(quint32(w.type), p + 8);
+    qToLittleEndian<quint32>(quint32(FEATURES), p + 12);
+    qToLittleEndian<quint32>(quint32(w.type == Mlp ? HIDDEN : 0), p + 16);
+    p += HEADER_SIZE;
+    for (float v : w.mean) writeFloat(p, v);
+    for (float v : w.stddev) writeFloat(p, v);
+    if (w.type == Linear) {
+        for (float v : w.w1[0]) writeFloat(p, v);
+        writeFloat(p, w.b1[0]);
+    } else {
+        for (const auto &row : w.w1) for (float v : row) writeFloat(p, v);
+        for (float v : w.b1) writeFloat(p, v);
+        for (float v : w.w2) writeFloat(p, v);
+        writeFloat(p, w.b2);
+    }
+
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    return f.write(bytes) == bytes.size();
+}
+
+float LearnedEvaluator::evaluate(const CheckerStore &pieces, const BoardGeometry &geometry,
+                                 Side perspective, Side toMove) const
+{
+    const float terminal = terminalValue(pieces, perspective);
+    if (terminal >= 0.0f) return terminal;
+    if (pieces.size() > EvalFeatures::MAX_PIECES) {
+        static const MaterialEvaluator material;
+        return material.evaluate(pieces, geometry, perspective, toMove);
+    }
+
+    alignas(32) float x[FEATURES];
+    EvalFeatures::extract(pieces, geometry, perspective, toMove, x);
+
+    // Одна позиция: блок из BLOCK столбцов считал бы впустую
+    if (type == Linear) {
+        float z = b1[0];
+        for (int i = 0; i < FEATURES; ++i) z += w1[0][i] * x[i];
+        return sigmoid(z);
+    }
+    float z = b2;
+    for (int j = 0; j < HIDDEN; ++j) {
+        float h = b1[j];
+        for (int i = 0; i < FEATURES; ++i) h += w1[j][i] * x[i];
+        z += w2[j] * qMax(0.0f, h);
+    }
+    return sigmoid(z);
+}
+
+void LearnedEvaluator::evaluateBatch(const float *features, int count, float *out) const
+{
+    // Блок позиций в столбцах: x[i][p] — признак i позиции p. Все циклы
+    // фиксированной длины, внутренний — по позициям блока.
+    alignas(32) float x[FEATURES][BLOCK];
+    alignas(32) float acc[BLOCK];
+    alignas(32) float hidden[BLOCK];
+
+    for (int base = 0; base < count; base += BLOCK) {
+        const int n = qMin(BLOCK, count - base);
+        for (int p = 0; p < BLOCK; ++p) {
+            const float *row = features + size_t(base + qMin(p, n - 1)) * FEATURES;
+            for (int i = 0; i < FEATURES; ++i) x[i][p] = row[i];
+        }
+
+        if (type == Linear) {
+            for (int p = 0; p < BLOCK; ++p) acc[p] = b1[0];
+            for (int i = 0; i < FEATURES; ++i) {
+                const float w = w1[0][i];
+                for (int p = 0; p < BLOCK; ++p) acc[p] += w * x[i][p];
+            }
+        } else {
+            for (int p = 0; p < BLOCK; ++p) acc[p] = b2;
+            for (int j = 0; j < HIDDEN; ++j) {
+                for (int p = 0; p < BLOCK; ++p) hidden[p] = b1[j];
+                for (int i = 0; i < FEATURES; ++i) {
+                    const float w = w1[j][i];
+                    for (int p = 0; p < BLOCK; ++p) hidden[p] += w * x[i][p];
+                }
+                const float v = w2[j];
+                for (int p = 0; p < BLOCK; ++p) acc[p] += v * qMax(0.0f, hidden[p]);
+            }
+        }
+
+        for (int p = 0; p < n; ++p) out[base + p] = sigmoid(acc[p]);
+    }
+}
+
+void LearnedEvaluator::evaluateBatch(const CheckerStore *const *pieces, const Side *toMove, int count,
+                                     const BoardGeometry &geometry, Side perspective, float *out) const
+{
+    // Законченные партии и слишком большие доски оцениваются сразу,
+    // остальные копятся в блок признаков
+    static const MaterialEvaluator material;
+    alignas(32) float features[BLOCK][FEATURES];
+    float values[BLOCK];
+    int rows[BLOCK];
+    for (int base = 0; base < count; base += BLOCK) {
+        const int end = qMin(count, base + BLOCK);
+        int n = 0;
+        for (int k = base; k < end; ++k) {
+            const float terminal = terminalValue(*pieces[k], perspective);
+            if (terminal >= 0.0f) {
+                out[k] = terminal;
+                continue;
+            }
+            if (pieces[k]->size() > EvalFeatures::MAX_PIECES) {
+                out[k] = material.evaluate(*pieces[k], geometry, perspective, toMove[k]);
+                continue;
+            }
+            EvalFeatures::extract(*pieces[k], geometry, perspective, toMove[k], features[n]);
+            rows[n++] = k;
+        }
+        if (n == 0) continue;
+        evaluateBatch(&features[0][0], n, values);
+        for (int p = 0; p < n; ++p) out[rows[p]] = values[p];
+    }
+}
+
+const LearnedEvaluator &LearnedEvaluator::shared()
+{
+    static LearnedEvaluator evaluator;
+    static const bool loaded = [] {
+        const QString dir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath()
+                                                         : QString(".");
+        return evaluator.load(dir + "/evaluator.weights");
+    }();
+    Q_UNUSED(loaded);
+    return evaluator;
+}
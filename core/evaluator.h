@@ -0,0 +1,128 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <QString>
+#include "checkerstore.h"
+
+// Оценка покоящейся позиции: ожидаемый результат партии для стороны
+// perspective в [0, 1] (1 — победа, 0.5 — ничья). Используется поиском
+// (листья MCTS) и может подменяться: ручная формула или обученная модель.
+class PositionEvaluator
+{
+public:
+    virtual ~PositionEvaluator() = default;
+
+    virtual float evaluate(const CheckerStore &pieces, const BoardGeometry &geometry,
+                           Side perspective, Side toMove) const = 0;
+
+    // Оценка пачки позиций (листья поиска): pieces[k] при ходе toMove[k] -> out[k].
+    // По умолчанию — evaluate по одной
+    virtual void evaluateBatch(const CheckerStore *const *pieces, const Side *toMove, int count,
+                               const BoardGeometry &geometry, Side perspective, float *out) const;
+
+    // Исход закончившейся партии; -1, если у обеих сторон есть шашки
+    static float terminalValue(const CheckerStore &pieces, Side perspective);
+};
+
+// Признаки позиции с точки зрения одной стороны. Все величины в долях
+// размера доски или числа шашек, поэтому не зависят от масштаба доски.
+struct EvalFeatures
+{
+    enum {
+        MaterialDiff,      // (свои - чужие) / шашек на сторону в начале
+        OwnCount,
+        EnemyCount,
+        OwnMeanMargin,     // среднее расстояние до края
+        EnemyMeanMargin,
+        OwnMinMargin,
+        EnemyMinMargin,
+        OwnEndangered,     // доля шашек ближе клетки к краю
+        EnemyEndangered,
+        OwnMeanGap,        // среднее расстояние до ближайшего врага
+        EnemyMeanGap,
+        EnemyTargets,      // чужие у края и рядом с нашей шашкой
+        OwnTargets,
+        OwnSpread,         // удалённость центра масс от центра доски
+        EnemySpread,
+        ToMove,            // 1 — ходит perspective
+        Count
+    };
+
+    // Больше шашек признаки не описывают: такие доски оцениваются материально
+    static constexpr int MAX_PIECES = 64;
+
+    // pieces.size() не больше MAX_PIECES
+    static void extract(const CheckerStore &pieces, const BoardGeometry &geometry,
+                        Side perspective, Side toMove, float *out);
+};
+
+// Ручная оценка: материал плюс небольшой запас до края (прежняя оценка листьев MCTS)
+class MaterialEvaluator : public PositionEvaluator
+{
+public:
+    float evaluate(const CheckerStore &pieces, const BoardGeometry &geometry,
+                   Side perspective, Side toMove) const override;
+};
+
+// Обученная модель над EvalFeatures: линейная (логистическая регрессия) или
+// MLP с одним скрытым слоем ReLU и сигмоидой на выходе. Веса фиксированного
+// размера и выровнены, нормализация признаков при загрузке вшивается в первый
+// слой. evaluateBatch считает блоками по BLOCK позиций, раскладывая признаки
+// по столбцам: внутренний цикл идёт по позициям блока и векторизуется.
+// Доски больше EvalFeatures::MAX_PIECES шашек оцениваются MaterialEvaluator.
+//
+// Файл весов (little-endian): "CHEV", версия, тип модели (0 — линейная,
+// 1 — MLP), число признаков, число скрытых нейронов; затем float32:
+// mean[F], std[F], далее для линейной w[F], b; для MLP W1[H][F], b1[H], w2[H], b2.
+class LearnedEvaluator : public PositionEvaluator
+{
+public:
+    enum ModelType { Linear = 0, Mlp = 1 };
+
+    static constexpr int FEATURES = EvalFeatures::Count;
+    static constexpr int HIDDEN = 16;
+    static constexpr int BLOCK = 8;
+    static constexpr quint32 FILE_VERSION = 2; // 2 — обучено на физике с учётом шага (Physics)
+
+    // Параметры модели в том виде, в каком их пишет обучение
+    struct Weights {
+        ModelType type = Mlp;
+        float mean[FEATURES] = {};
+        float stddev[FEATURES] = {};
+        float w1[HIDDEN][FEATURES] = {}; // у линейной модели используется строка 0
+        float b1[HIDDEN] = {};
+        float w2[HIDDEN] = {};
+        float b2 = 0.0f;
+    };
+
+    LearnedEvaluator();
+
+    bool load(const QString &path);
+    static bool save(const QString &path, const Weights &weights);
+    void setWeights(const Weights &weights);
+    bool isLoaded() const { return loaded; }
+    ModelType modelType() const { return type; }
+
+    float evaluate(const CheckerStore &pieces, const BoardGeometry &geometry,
+                   Side perspective, Side toMove) const override;
+    // Признаки пачки собираются блоками по BLOCK и считаются одним evaluateBatch
+    void evaluateBatch(const CheckerStore *const *pieces, const Side *toMove, int count,
+                       const BoardGeometry &geometry, Side perspective, float *out) const override;
+
+    // Оценка по готовым признакам: features[count][FEATURES] -> out[count]
+    void evaluateBatch(const float *features, int count, float *out) const;
+
+    // Модель evaluator.weights рядом с исполняемым файлом (не загружена, если файла нет)
+    static const LearnedEvaluator &shared();
+
+private:
+    ModelType type;
+    bool loaded;
+    // Нормализация уже вшита: x * w1 + b1 ожидает сырые признаки
+    alignas(32) float w1[HIDDEN][FEATURES];
+    alignas(32) float b1[HIDDEN];
+    alignas(32) float w2[HIDDEN];
+    float b2;
+};
+
+#endif // EVALUATOR_H
@@ -0,0 +1,779 @@
+#include "gamelogic.h"
+#include "logger.h"
+#include "trace.h"
+#include <cmath>
+#include <algorithm>
+#include <QRandomGenerator>
+
+GameLogic::GameLogic()
+    : boardLeft(100), boardTop(100), boardSize(600), boardCells(8),
+    winnerColor(""), gameOver(false), botDifficulty(Medium), gridDirty(true)
+{
+}
+
+float GameLogic::length(const QPointF &v) const {
+    return std::sqrt(v.x()*v.x() + v.y()*v.y());
+}
+
+// Шашка полностью покинула игровое поле (центр +/− радиус за пределами границ)
+bool GameLogic::isOffBoard(float x, float y, float radius) const
+{
+    return geometry().isOffBoard(x, y, radius);
+}
+
+void GameLogic::initBoard(int rowsPerSide)
+{
+    checkers.clear();
+    initialPositions.clear(); // Очищаем начальные позиции
+
+    const float cell = cellSize();
+    const int perRow = boardCells / 2;
+    checkers.reserve(2 * rowsPerSide * perRow);
+    initialPositions.reserve(2 * rowsPerSide * perRow);
+
+    // Расстановка одной стороны: rowsPerSide рядов, начиная с firstRow, в шахматном порядке
+    auto placeSide = [&](int firstRow, Side s) {
+        for (int row = 0; row < rowsPerSide; ++row) {
+            for (int col = 0; col < perRow; ++col) {
+                int actualRow = firstRow + row;
+                int actualCol = col * 2 + ((row % 2 == 0) ? 1 : 0);
+
+                float x = boardLeft + cell * (actualCol + 0.5f);
+                float y = boardTop + cell * (actualRow + 0.5f);
+
+                checkers.add(x, y, s);
+                // Сохраняем относительную позицию (0-1 относительно доски)
+                initialPositions.push_back(QPointF((x - boardLeft) / boardSize,
+                                                   (y - boardTop) / boardSize));
+            }
+        }
+    };
+
+    // БЕЛЫЕ ШАШКИ (нижние ряды для игрока)
+    placeSide(boardCells - rowsPerSide, Side::White);
+    // ЧЕРНЫЕ ШАШКИ (верхние ряды для бота)
+    placeSide(0, Side::Black);
+
+    gameOver = false;
+    winnerColor = "";
+    syncPreviousPositions();
+    gridDirty = true;
+
+    logDebug(lcBoard) << "Доска расставлена: размер" << boardSize << "клеток:" << boardCells
+                      << "позиция:" << boardLeft << boardTop << "ячейка:" << cell
+                      << "белых:" << aliveCount(Side::White) << "черных:" << aliveCount(Side::Black);
+}
+
+// НОВЫЙ МЕТОД: обновление позиций шашек при изменении размера доски
+void GameLogic::updateCheckerPositions()
+{
+    // Обновляем только если шашки не двигаются
+    if (isMoving()) return;
+
+    // используем initialPositions, boardLeft/boardTop/boardSize напрямую
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (!checkers.isAlive(i)) continue;
+
+        // Восстанавливаем позицию из относительных координат
+        checkers.x[i] = boardLeft + initialPositions[i].x() * boardSize;
+        checkers.y[i] = boardTop + initialPositions[i].y() * boardSize;
+
+        checkers.vx[i] = 0.0f; // Сбрасываем скорость
+        checkers.vy[i] = 0.0f;
+    }
+    syncPreviousPositions();
+    gridDirty = true;
+
+    logDebug(lcBoard) << "Позиции шашек обновлены под новый размер доски:" << boardSize;
+}
+
+bool GameLogic::saveState(GameState &state, Side toMove) const
+{
+    return state.capture(checkers, geometry(), toMove);
+}
+
+void GameLogic::restoreState(const GameState &state)
+{
+    state.restore(checkers, geometry());
+    gameOver = false;
+    winnerColor = "";
+    syncPreviousPositions();
+    gridDirty = true;
+}
+
+// Запоминаем текущие позиции как "предыдущее" физическое состояние
+void GameLogic::syncPreviousPositions()
+{
+    prevX.resize(checkers.size());
+    prevY.resize(checkers.size());
+    std::copy(checkers.x.cbegin(), checkers.x.cend(), prevX.begin());
+    std::copy(checkers.y.cbegin(), checkers.y.cend(), prevY.begin());
+}
+
+QPointF GameLogic::renderPosition(int index, float alpha) const
+{
+    return QPointF(prevX[index] + (checkers.x[index] - prevX[index]) * alpha,
+                   prevY[index] + (checkers.y[index] - prevY[index]) * alpha);
+}
+
+// ... остальные методы без изменений ...
+
+void GameLogic::update(float dt)
+{
+    TRACE_ZONE("GameLogic::update");
+    if (gameOver) return;
+
+    syncPreviousPositions();
+
+    const float radius = checkerRadius();
+    if (grid.configure(boardLeft, boardTop, boardSize, 2 * radius) || gridDirty) {
+        rebuildGrid();
+    }
+
+    const int n = checkers.size();
+    float *xs = checkers.x.data();
+    float *ys = checkers.y.data();
+    float *vxs = checkers.vx.data();
+    float *vys = checkers.vy.data();
+
+    // Двигаем шашки на путь за dt, разрешая столкновения в порядке касаний (только между живыми)
+    handleCollisions(Physics::travel(dt));
+
+    // Трение: скорость к концу шага
+    const float decay = Physics::velocityDecay(dt);
+    for (int i = 0; i < n; ++i) {
+        if (!checkers.isAlive(i)) continue;
+        vxs[i] *= decay;
+        vys[i] *= decay;
+    }
+
+    // Помечаем шашки как неактивные, как только центр шашки полностью ушёл за
+    // пределы доски (т.е. шашка полностью покинула игровую область).
+    for (int i = 0; i < n; ++i) {
+        if (!checkers.isAlive(i)) continue;
+
+        if (isOffBoard(xs[i], ys[i], radius)) {
+            checkers.kill(i);
+            grid.remove(i);
+            logDebug(lcPhysics) << "Шашка полностью покинула поле и помечена как неактивная. Цвет:"
+                                << (checkers.side[i] == Side::White ? "белая" : "черная")
+                                << "поз:" << xs[i] << ys[i];
+            continue;
+        }
+
+        grid.move(i, xs[i], ys[i]);
+
+        // Небольшие "подтягивания" больше не выполняются - шашки могут выезжать.
+        // При этом, если шашка немного ушла за край (но ещё не полностью),
+        // она остаётся активной и может вернуться обратно в результате столкновений.
+    }
+}
+
+void GameLogic::rebuildGrid()
+{
+    grid.configure(boardLeft, boardTop, boardSize, 2 * checkerRadius());
+    grid.clear(checkers.size());
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (checkers.isAlive(i)) grid.insert(i, checkers.x[i], checkers.y[i]);
+    }
+    gridDirty = false;
+}
+
+// Непрерывное (swept) обнаружение столкновений. В пределах шага все шашки
+// проходят один и тот же путь на единицу скорости (Physics::travel), и
+// положение линейно по нему: x = x0 + v * s, где v — скорость в начале шага.
+// Трение масштабирует скорости обеих шашек одинаково, а удар линеен по
+// скоростям, поэтому его можно применять к v. Для каждой пары-кандидата ищется
+// путь до касания |d + w*s| = 2r, и столкновения разрешаются строго по
+// порядку. Так быстрая шашка не "проскакивает" сквозь другую, а касательные
+// удары не теряются.
+void GameLogic::handleCollisions(float travel)
+{
+    TRACE_ZONE("GameLogic::handleCollisions");
+    const float radius = checkerRadius();
+    const float diameter = 2 * radius;
+    const float diameter2 = diameter * diameter;
+    const int n = checkers.size();
+    float *xs = checkers.x.data();
+    float *ys = checkers.y.data();
+    float *vxs = checkers.vx.data();
+    float *vys = checkers.vy.data();
+
+    // Насколько далеко за шаг может сместиться самая быстрая шашка
+    float maxSpeed2 = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        if (!checkers.isAlive(i)) continue;
+        maxSpeed2 = qMax(maxSpeed2, vxs[i] * vxs[i] + vys[i] * vys[i]);
+    }
+    // Две шашки сближаются не быстрее удвоенной максимальной скорости
+    const float reach = 2.0f * std::sqrt(maxSpeed2) * travel;
+
+    // Кандидаты — пары, которые за шаг могут коснуться: ячейки сетки в пределах
+    // диаметра + reach, затем отсев по квадрату расстояния (без sqrt)
+    const int ring = 1 + static_cast<int>(reach / diameter);
+    const float reachDist2 = (diameter + reach) * (diameter + reach);
+    contactA.clear();
+    contactB.clear();
+    grid.forEachCandidatePair(ring, [&](int i, int j) {
+        float dx = xs[j] - xs[i];
+        float dy = ys[j] - ys[i];
+        if (dx * dx + dy * dy >= reachDist2) return;
+        contactA.push_back(i);
+        contactB.push_back(j);
+    });
+    const int pairCount = contactA.size();
+
+    auto advance = [&](float s) {
+        for (int i = 0; i < n; ++i) {
+            if (!checkers.isAlive(i)) continue;
+            xs[i] += vxs[i] * s;
+            ys[i] += vys[i] * s;
+        }
+    };
+
+    // Событие за событием: находим ближайшее касание, доводим все шашки до него,
+    // меняем скорости пары и продолжаем с остатком шага
+    const int MAX_EVENTS_PER_STEP = 64;
+    float remaining = travel;
+    for (int event = 0; event < MAX_EVENTS_PER_STEP && remaining > 0.0f; ++event) {
+        float firstT = remaining;
+        int first = -1;
+
+        for (int k = 0; k < pairCount; ++k) {
+            const int i = contactA[k];
+            const int j = contactB[k];
+            const float dx = xs[j] - xs[i];
+            const float dy = ys[j] - ys[i];
+            const float wx = vxs[j] - vxs[i];
+            const float wy = vys[j] - vys[i];
+
+            const float b = dx * wx + dy * wy;
+            if (b >= 0.0f) continue; // не сближаются
+
+            const float c = dx * dx + dy * dy - diameter2;
+            float t = 0.0f;
+            if (c > 0.0f) {
+                const float a = wx * wx + wy * wy;
+                // У "остановившихся" шашек скорости затухают до денормализованных
+                // чисел: a обнуляется, и деление дало бы -inf и NaN в позициях
+                if (a <= 0.0f) continue;
+                const float disc = b * b - a * c;
+                if (disc < 0.0f) continue; // проходят мимо
+                t = qMax(0.0f, (-b - std::sqrt(disc)) / a);
+            }
+            // c <= 0 — уже касаются и сближаются: удар немедленно
+
+            if (t < firstT) {
+                firstT = t;
+                first = k;
+            }
+        }
+
+        if (first < 0) break;
+
+        advance(firstT);
+        remaining -= firstT;
+
+        // Удар: обмен импульсом вдоль линии центров
+        const int i = contactA[first];
+        const int j = contactB[first];
+        const float dx = xs[j] - xs[i];
+        const float dy = ys[j] - ys[i];
+        const float dist = std::sqrt(dx * dx + dy * dy);
+        if (dist <= 0.0f) continue;
+        const float nx = dx / dist;
+        const float ny = dy / dist;
+
+        Physics::collide(vxs, vys, i, j, nx, ny);
+    }
+
+    if (remaining > 0.0f) advance(remaining);
+
+    // Остаточные перекрытия (погрешности, плотные скопления) раздвигаем как раньше
+    for (int k = 0; k < pairCount; ++k) {
+        const int i = contactA[k];
+        const int j = contactB[k];
+        const float dx = xs[j] - xs[i];
+        const float dy = ys[j] - ys[i];
+        const float dist2 = dx * dx + dy * dy;
+        if (dist2 >= diameter2 || dist2 <= 0.0f) continue;
+
+        const float dist = std::sqrt(dist2);
+        const float nx = dx / dist;
+        const float ny = dy / dist;
+        const float overlap = diameter - dist;
+
+        xs[i] -= nx * overlap / 2.0f;
+        ys[i] -= ny * overlap / 2.0f;
+        xs[j] += nx * overlap / 2.0f;
+        ys[j] += ny * overlap / 2.0f;
+    }
+}
+
+namespace {
+
+// Нормально распределённое число (преобразование Бокса — Мюллера)
+float gaussian(QRandomGenerator &rng)
+{
+    const double u1 = 1.0 - rng.generateDouble();
+    const double u2 = rng.generateDouble();
+    return static_cast<float>(std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * 3.14159265 * u2));
+}
+
+// Кандидат в список лучших ударов по убыванию оценки. Близкий удар той же
+// шашки не добавляется, а заменяет прежний, если он лучше.
+void insertCandidate(QVector<BotMove> &top, int capacity, const BotMove &move, float separation)
+{
+    int at = -1;
+    for (int t = 0; t < top.size(); ++t) {
+        const QPointF d = top[t].force - move.force;
+        if (top[t].checkerIndex == move.checkerIndex
+            && d.x() * d.x() + d.y() * d.y() < separation * separation) {
+            if (move.score <= top[t].score) return;
+            at = t;
+            break;
+        }
+    }
+    if (at < 0) {
+        if (top.size() >= capacity && move.score <= top.last().score) return;
+        if (top.size() >= capacity) top.removeLast();
+        top.push_back(move);
+        at = top.size() - 1;
+    }
+    top[at] = move;
+    while (at > 0 && top[at - 1].score < top[at].score) {
+        std::swap(top[at - 1], top[at]);
+        --at;
+    }
+}
+
+// Образец удара для метода перекрёстной энтропии
+struct ShotSample {
+    float offsetDeg;
+    float power;
+    float score;
+};
+
+} // namespace
+
+BotLimits GameLogic::botLimits(BotDifficulty difficulty)
+{
+    // Easy — только грубая эвристика; Medium проверяет кандидатов симуляцией
+    // в один поток; Hard проверяет и уточняет удары на всех ядрах до конца
+    // бюджета; Master — MCTS (MctsBot) на всех ядрах
+    switch (difficulty) {
+    case Easy:   return { 20.0f, 1, 0, 48 };
+    case Medium: return { 60.0f, 1, 1, 160 };
+    case Hard:   return { 250.0f, 0, 2, 480 };
+    case Master: return { 400.0f, 0, 0, 480 };
+    }
+    return { 60.0f, 1, 1, 160 };
+}
+
+BotMove GameLogic::findBestMove(Side botSide, const std::atomic<bool> *cancel) const
+{
+    TRACE_ZONE("GameLogic::findBestMove");
+    const BotMove bestMove = searchShot(botSide, botLimits(botDifficulty).evaluations, cancel);
+
+    if (bestMove.checkerIndex >= 0) {
+        logDebug(lcBot) << "Лучший ход бота: шашка" << bestMove.checkerIndex
+                        << "сила:" << bestMove.force << "очки:" << bestMove.score;
+    }
+    return bestMove;
+}
+
+BotMove GameLogic::searchShot(Side botSide, int budget, const std::atomic<bool> *cancel) const
+{
+    return runShotSearch(botSide, budget, cancel, nullptr, 0);
+}
+
+QVector<BotMove> GameLogic::searchCandidates(Side botSide, int budget, int count,
+                                             const std::atomic<bool> *cancel) const
+{
+    QVector<BotMove> top;
+    if (count <= 0) return top;
+    top.reserve(count + 1);
+    runShotSearch(botSide, budget, cancel, &top, count);
+    if (cancel && cancel->load()) top.clear();
+    return top;
+}
+
+BotMove GameLogic::runShotSearch(Side botSide, int budget, const std::atomic<bool> *cancel,
+                                 QVector<BotMove> *top, int topCount) const
+{
+    // Получаем шашки бота
+    QVector<int> botCheckers = getCheckersOf(botSide);
+
+    if (botCheckers.isEmpty() || budget <= 0) return {-1, QPointF(0,0), -1000};
+
+    // Область поиска одна для всех уровней — сложность задаёт только бюджет
+    const float SPREAD_DEG = 90.0f;   // отклонение от направления на ближайшего врага
+    const float POWER_MIN = 90.0f;
+    const float POWER_MAX = 400.0f;
+    const int ROUNDS = 4;
+    const int ELITES = 4;             // лучших образцов для пересчёта распределения
+    const float TOP_SEPARATION = 15.0f; // удары одной шашки ближе по силе — один кандидат
+
+    // "Рука" — шашка со своим распределением угла и силы
+    struct Arm {
+        int checker;
+        float bearingDeg;
+        float muAngle, sigmaAngle;
+        float muPower, sigmaPower;
+        float best;
+        ShotSample elites[ELITES];
+        int eliteCount;
+    };
+
+    const Side enemySide = opponentOf(botSide);
+    const int n = checkers.size();
+    const float *xs = checkers.x.constData();
+    const float *ys = checkers.y.constData();
+    const Side *sides = checkers.side.constData();
+
+    QVector<Arm> arms;
+    arms.reserve(botCheckers.size());
+    for (int checkerIndex : botCheckers) {
+        const float sx = xs[checkerIndex];
+        const float sy = ys[checkerIndex];
+
+        // находим ближайшую вражескую шашку как цель
+        float bestD2 = 1e18f;
+        float tx = sx, ty = sy + boardSize * 0.2f; // если врагов нет — двигаться "вперёд" по Y
+        for (int i = 0; i < n; ++i) {
+            if (sides[i] != enemySide || !checkers.isAlive(i)) continue;
+            float dx = xs[i] - sx;
+            float dy = ys[i] - sy;
+            float d2 = dx * dx + dy * dy;
+            if (d2 < bestD2) { bestD2 = d2; tx = xs[i]; ty = ys[i]; }
+        }
+
+        QPointF dir(tx - sx, ty - sy);
+        float dirLen = length(dir);
+        if (dirLen > 0.0001f) dir /= dirLen;
+        else dir = QPointF(0.0f, (botSide == Side::Black) ? 1.0f : -1.0f);
+
+        Arm arm;
+        arm.checker = checkerIndex;
+        arm.bearingDeg = std::atan2(dir.y(), dir.x()) * 180.0f / 3.14159265f;
+        arm.muAngle = 0.0f;
+        arm.sigmaAngle = SPREAD_DEG / 2.0f;
+        arm.muPower = (POWER_MIN + POWER_MAX) / 2.0f;
+        arm.sigmaPower = (POWER_MAX - POWER_MIN) / 2.0f;
+        arm.best = -1e30f;
+        arm.eliteCount = 0;
+        arms.push_back(arm);
+    }
+
+    // Детерминированный генератор: один и тот же ход в одной и той же позиции
+    QRandomGenerator rng(0x5eed0000u + quint32(n));
+    BotMove bestMove = {-1, QPointF(0, 0), -1e30f};
+    int used = 0;
+    int active = arms.size();
+
+    // Метод перекрёстной энтропии по (угол, сила) для каждой шашки; между
+    // раундами худшая половина шашек отсеивается (последовательное деление
+    // пополам), так что оценки уходят туда, где сгущаются хорошие удары
+    for (int round = 0; round < ROUNDS && used < budget; ++round) {
+        const int roundBudget = (budget - used) / (ROUNDS - round);
+        const int perArm = qMax(2, roundBudget / active);
+
+        for (int a = 0; a < active && used < budget; ++a) {
+            Arm &arm = arms[a];
+            arm.eliteCount = 0;
+
+            for (int s = 0; s < perArm && used < budget; ++s) {
+                if (cancel && cancel->load(std::memory_order_relaxed)) {
+                    return {-1, QPointF(0, 0), -1000};
+                }
+
+                // Прямой удар в цель средней силой всегда попадает в выборку
+                float offset = 0.0f;
+                float power = (POWER_MIN + POWER_MAX) / 2.0f;
+                if (round > 0 || s > 0) {
+                    offset = qBound(-SPREAD_DEG, arm.muAngle + arm.sigmaAngle * gaussian(rng), SPREAD_DEG);
+                    power = qBound(POWER_MIN, arm.muPower + arm.sigmaPower * gaussian(rng), POWER_MAX);
+                }
+
+                const float rad = (arm.bearingDeg + offset) * 3.14159265f / 180.0f;
+                const QPointF force(std::cos(rad) * power, std::sin(rad) * power);
+                const float score = evaluateMove(arm.checker, force);
+                used++;
+
+                if (score > bestMove.score) bestMove = {arm.checker, force, score};
+                arm.best = qMax(arm.best, score);
+                if (top) insertCandidate(*top, topCount, {arm.checker, force, score}, TOP_SEPARATION);
+
+                // Потоковый top-k: храним только ELITES лучших образцов раунда
+                int k = arm.eliteCount < ELITES ? arm.eliteCount++ : ELITES;
+                if (k == ELITES) {
+                    if (score <= arm.elites[ELITES - 1].score) continue;
+                    k = ELITES - 1;
+                }
+                while (k > 0 && arm.elites[k - 1].score < score) {
+                    arm.elites[k] = arm.elites[k - 1];
+                    --k;
+                }
+                arm.elites[k] = {offset, power, score};
+            }
+
+            // Сдвигаем распределение к лучшим образцам, разброс сужается плавно
+            float meanA = 0.0f, meanP = 0.0f;
+            for (int e = 0; e < arm.eliteCount; ++e) {
+                meanA += arm.elites[e].offsetDeg;
+                meanP += arm.elites[e].power;
+            }
+            meanA /= arm.eliteCount;
+            meanP /= arm.eliteCount;
+            float varA = 0.0f, varP = 0.0f;
+            for (int e = 0; e < arm.eliteCount; ++e) {
+                varA += (arm.elites[e].offsetDeg - meanA) * (arm.elites[e].offsetDeg - meanA);
+                varP += (arm.elites[e].power - meanP) * (arm.elites[e].power - meanP);
+            }
+            arm.muAngle = meanA;
+            arm.muPower = meanP;
+            arm.sigmaAngle = qMax(1.5f, 0.5f * arm.sigmaAngle + 0.5f * std::sqrt(varA / arm.eliteCount));
+            arm.sigmaPower = qMax(5.0f, 0.5f * arm.sigmaPower + 0.5f * std::sqrt(varP / arm.eliteCount));
+        }
+
+        // Оставляем лучшую половину шашек
+        std::sort(arms.begin(), arms.begin() + active,
+                  [](const Arm &l, const Arm &r) { return l.best > r.best; });
+        active = qMax(1, (active + 1) / 2);
+    }
+
+    return bestMove;
+}
+
+float GameLogic::botSpeedMultiplier(BotDifficulty difficulty)
+{
+    // скорость/мощность выстрела бота зависит от выбранной сложности
+    switch (difficulty) {
+    case Easy:   return 0.7f;
+    case Medium: return 1.0f;
+    case Hard:   return 1.35f; // AnytimeBot разыгрывает кандидатов уже с множителем
+    case Master: return 1.35f; // MctsBot разыгрывает свои удары уже с множителем
+    }
+    return 1.0f;
+}
+
+BotMove GameLogic::fallbackMove(Side botSide, QRandomGenerator &rng) const
+{
+    const QVector<int> botCheckers = getCheckersOf(botSide);
+    const QVector<int> enemyCheckers = getCheckersOf(opponentOf(botSide));
+    const float forward = (botSide == Side::Black) ? 1.0f : -1.0f;
+
+    float angleNoiseDeg = 18.0f;
+    float forceNoisePct = 0.25f;
+    int candidatesPerChecker = 3;
+    switch (botDifficulty) {
+    case Easy:   angleNoiseDeg = 40.0f; forceNoisePct = 0.5f;  candidatesPerChecker = 1; break;
+    case Medium: angleNoiseDeg = 18.0f; forceNoisePct = 0.25f; candidatesPerChecker = 3; break;
+    case Hard:
+    case Master: angleNoiseDeg = 6.0f;  forceNoisePct = 0.10f; candidatesPerChecker = 6; break;
+    default: break;
+    }
+
+    BotMove best = {-1, QPointF(0, 0), -1e30f};
+    for (int bi : botCheckers) {
+        QPointF startPos = getCheckerPosition(bi);
+
+        QPointF bestTarget = startPos;
+        if (!enemyCheckers.isEmpty()) {
+            float bestD = 1e9f;
+            for (int wi : enemyCheckers) {
+                QPointF wp = getCheckerPosition(wi);
+                float d = std::hypot(wp.x() - startPos.x(), wp.y() - startPos.y());
+                if (d < bestD) { bestD = d; bestTarget = wp; }
+            }
+        } else {
+            bestTarget = QPointF(startPos.x(), startPos.y() + forward);
+        }
+
+        QPointF dir = bestTarget - startPos;
+        float len = std::hypot(dir.x(), dir.y());
+        if (len > 0.0f) dir /= len;
+        else dir = QPointF(0.0f, forward);
+
+        for (int c = 0; c < candidatesPerChecker; ++c) {
+            float frac = (candidatesPerChecker > 1) ? (float)c / (candidatesPerChecker - 1) : 0.5f;
+            float angleOffset = (frac - 0.5f) * 2.0f * angleNoiseDeg;
+            float angleRad = angleOffset * (3.14159265f / 180.0f);
+            float cosA = std::cos(angleRad);
+            float sinA = std::sin(angleRad);
+            QPointF dirRot(dir.x()*cosA - dir.y()*sinA, dir.x()*sinA + dir.y()*cosA);
+
+            float baseForce = qBound(80.0f, len * 0.8f, 300.0f);
+            float rnd = static_cast<float>(rng.generateDouble());
+            float forceMult = baseForce * (1.0f - forceNoisePct * rnd);
+            QPointF forceVec = dirRot * forceMult;
+
+            const float BOT_MAX_FORCE = 500.0f;
+            float fLen = std::hypot(forceVec.x(), forceVec.y());
+            if (fLen > BOT_MAX_FORCE) forceVec *= (BOT_MAX_FORCE / fLen);
+
+            float score = evaluateMove(bi, forceVec);
+            if (score > best.score) best = { bi, forceVec, score };
+        }
+    }
+    return best;
+}
+
+void GameLogic::shoot(int checkerIndex, const QPointF &force)
+{
+    if (gameOver || checkerIndex < 0 || checkerIndex >= checkers.size()) return;
+
+    if (checkers.isAlive(checkerIndex)) {
+        checkers.vx[checkerIndex] = force.x();
+        checkers.vy[checkerIndex] = force.y();
+        logDebug(lcGame) << "Выстрел по шашке" << checkerIndex << "сила:" << force;
+    }
+}
+
+int GameLogic::aliveCount(Side s) const
+{
+    return checkers.aliveCount(s);
+}
+
+bool GameLogic::checkGameOver() const
+{
+    int whiteAlive = aliveCount(Side::White);
+    int blackAlive = aliveCount(Side::Black);
+
+    // Игра заканчивается только если у одной из сторон не осталось шашек
+    // (вызывается часто — без журнала; итог пишет winner)
+    return whiteAlive == 0 || blackAlive == 0;
+}
+
+QString GameLogic::winner() const
+{
+    int whiteAlive = aliveCount(Side::White);
+    int blackAlive = aliveCount(Side::Black);
+
+    if (whiteAlive == 0 && blackAlive == 0) {
+        logInfo(lcGame) << "Ничья - все шашки выбиты";
+        return "draw";
+    }
+    if (whiteAlive == 0) {
+        logInfo(lcGame) << "Победа черных, у них осталось:" << blackAlive;
+        return "black";
+    }
+    if (blackAlive == 0) {
+        logInfo(lcGame) << "Победа белых, у них осталось:" << whiteAlive;
+        return "white";
+    }
+    return "none";
+}
+
+bool GameLogic::isMoving() const
+{
+    const float *vxs = checkers.vx.constData();
+    const float *vys = checkers.vy.constData();
+    // Сравниваем квадрат скорости с квадратом порога — без sqrt
+    const float rest2 = Physics::REST_SPEED * Physics::REST_SPEED;
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (vxs[i] * vxs[i] + vys[i] * vys[i] > rest2 && checkers.isAlive(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int GameLogic::getCheckerAtPosition(const QPointF &pos) const
+{
+    const float radius = checkerRadius();
+
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (!checkers.isAlive(i)) continue;
+
+        float dist = length(pos - QPointF(checkers.x[i], checkers.y[i]));
+        if (dist <= radius) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Side GameLogic::getCheckerSide(int index) const
+{
+    if (index >= 0 && index < checkers.size()) {
+        return checkers.side[index];
+    }
+    return Side::White;
+}
+
+QPointF GameLogic::getCheckerPosition(int index) const
+{
+    if (index >= 0 && index < checkers.size()) {
+        return QPointF(checkers.x[index], checkers.y[index]);
+    }
+    return QPointF(0, 0);
+}
+
+QVector<int> GameLogic::getCheckersOf(Side s) const
+{
+    QVector<int> result;
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (checkers.side[i] == s && checkers.isAlive(i)) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+float GameLogic::evaluateMove(int checkerIndex, const QPointF &force) const
+{
+    TRACE_ZONE("GameLogic::evaluateMove");
+    if (checkerIndex < 0 || checkerIndex >= checkers.size()) return -1000;
+    if (!checkers.isAlive(checkerIndex)) return -1000;
+
+    const float radius = checkerRadius();
+
+    // Базовая ценность силы — но не делаем силу единственным критерием
+    float score = 0.2f * length(force);
+
+    // Где шашка остановится, если ни во что не врежется (чтобы понять, попадём ли в противника)
+    QPointF predictedPos = Physics::restPosition(getCheckerPosition(checkerIndex), force);
+    const float px = predictedPos.x();
+    const float py = predictedPos.y();
+
+    // Штраф за вылет за пределы (как только шашка полностью покинет поле, оцениваем это плохо)
+    if (isOffBoard(px, py, radius)) {
+        score -= 250.0f; // существенный штраф — бот должен избегать потери шашки
+    } else {
+        score += 20.0f; // бонус за то, что шашка останется на доске
+    }
+
+    // Бонус за потенциальный удар по вражеской шашке
+    const Side enemySide = opponentOf(checkers.side[checkerIndex]);
+    const float *xs = checkers.x.constData();
+    const float *ys = checkers.y.constData();
+    const Side *sides = checkers.side.constData();
+    const float hitDist2 = (radius * 1.4f) * (radius * 1.4f);
+    float bestDist2 = 1e18f;
+    int potentialHits = 0;
+    for (int i = 0; i < checkers.size(); ++i) {
+        if (sides[i] != enemySide || !checkers.isAlive(i)) continue;
+        float dx = px - xs[i];
+        float dy = py - ys[i];
+        float d2 = dx * dx + dy * dy;
+        if (d2 < bestDist2) bestDist2 = d2;
+        if (d2 < hitDist2) potentialHits++;
+    }
+    if (potentialHits > 0) {
+        // сильный бонус за возможность попасть в противника
+        score += 220.0f + potentialHits * 80.0f;
+    } else {
+        // если близко к вражеской шашке — небольшой бонус
+        if (bestDist2 < (radius * 4.0f) * (radius * 4.0f)) score += 60.0f;
+    }
+
+    // Небольшая штрафная поправка за слишком "сильную" силу, если это не ведёт к атаке
+    if (potentialHits == 0) {
+        float fmag = length(force);
+        if (fmag > 350.0f) score -= (fmag - 350.0f) * 0.25f;
+    }
+
+    // Возвращаем комбинированную оценку
+    return score;
+}
@@ -0,0 +1,143 @@
+#ifndef GAMELOGIC_H
+#define GAMELOGIC_H
+
+#include <QPointF>
+#include <QVector>
+#include <QString>
+#include <atomic>
+#include "checkerstore.h"
+#include "gamestate.h"
+#include "physics.h"
+#include "spatialgrid.h"
+
+class QRandomGenerator;
+
+// ДОБАВИТЬ ПЕРЕД КЛАССОМ GameLogic
+struct BotMove {
+    int checkerIndex;
+    QPointF force;
+    float score;
+};
+
+// ДОБАВИТЬ ПЕРЕД КЛАССОМ GameLogic
+enum BotDifficulty {
+    Easy,
+    Medium,
+    Hard,
+    Master  // поиск по дереву Монте-Карло (MctsBot), см. BotWorker
+};
+
+// Ограничения бота на один ход по уровню сложности. Время — жёсткий предел:
+// поиск "в любой момент" (AnytimeBot, MctsBot) к этому сроку отдаёт лучший
+// найденный ход, поэтому задержка хода не зависит от числа шашек и машины.
+struct BotLimits {
+    float budgetMs;   // время на ход
+    int threads;      // рабочих для поиска: 0 — все рабочие общего пула
+    int maxDepth;     // 0 — только эвристика; 1 — проверка симуляцией; 2 — и уточнение до конца срока
+    int evaluations;  // оценок evaluateMove на эвристический поиск кандидатов
+};
+
+class GameLogic
+{
+public:
+    GameLogic();
+
+    // Шаг игрового цикла; сама модель движения — в Physics
+    static constexpr float PHYSICS_STEP = Physics::STEP;
+
+    float boardLeft;
+    float boardTop;
+    float boardSize;
+    int boardCells; // клеток на сторону доски (8 — стандарт, больше — для больших вариантов)
+
+    // rowsPerSide — сколько рядов у каждой стороны заполняется шашками
+    void initBoard(int rowsPerSide = 2);
+    void update(float dt);
+    // Позиция шашки для отрисовки: alpha в [0, 1] — доля пути между двумя
+    // последними физическими шагами (интерполяция при фиксированном шаге физики)
+    QPointF renderPosition(int index, float alpha) const;
+    void shoot(int checkerIndex, const QPointF &force);
+    void updateCheckerPositions();
+
+    // Новый метод: масштабирование/пересчёт позиций при смене геометрии доски
+    void rescaleBoard(float oldLeft, float oldTop, float oldSize,
+                      float newLeft, float newTop, float newSize);
+
+    bool checkGameOver() const;
+    QString winner() const;
+    bool isMoving() const;
+    int getCheckerAtPosition(const QPointF &pos) const;
+    Side getCheckerSide(int index) const;
+    QPointF getCheckerPosition(int index) const;
+    QVector<int> getCheckersOf(Side s) const;
+    QVector<int> getBlackCheckers() const { return getCheckersOf(Side::Black); }
+    QVector<int> getWhiteCheckers() const { return getCheckersOf(Side::White); }
+    int aliveCount(Side s) const;
+    float evaluateMove(int checkerIndex, const QPointF &force) const;
+
+    // ДОБАВИТЬ НОВЫЕ МЕТОДЫ ДЛЯ УМНОГО БОТА
+    // cancel — необязательный флаг отмены: при его взводе поиск прерывается
+    // и возвращает ход с checkerIndex = -1
+    BotMove findBestMove(Side botSide, const std::atomic<bool> *cancel = nullptr) const;
+    // Адаптивный поиск удара: не больше budget вызовов evaluateMove
+    BotMove searchShot(Side botSide, int budget, const std::atomic<bool> *cancel = nullptr) const;
+    // Тот же поиск, но возвращает до count лучших несовпадающих ударов (по убыванию оценки)
+    QVector<BotMove> searchCandidates(Side botSide, int budget, int count,
+                                      const std::atomic<bool> *cancel = nullptr) const;
+    // Время, потоки и глубина поиска для уровня сложности
+    static BotLimits botLimits(BotDifficulty difficulty);
+    // Запасной ход, если поиск ничего не дал: несколько кандидатов с шумом
+    // по углу и силе (шум задаёт сложность), лучший по evaluateMove
+    BotMove fallbackMove(Side botSide, QRandomGenerator &rng) const;
+    // Множитель силы удара бота по уровню сложности
+    static float botSpeedMultiplier(BotDifficulty difficulty);
+    void setBotDifficulty(BotDifficulty difficulty) { botDifficulty = difficulty; }
+    BotDifficulty getBotDifficulty() const { return botDifficulty; }
+
+    // Представление шашек только для чтения (вместо прежнего getCheckers())
+    CheckersView checkersView() const { return CheckersView(checkers); }
+    const CheckerStore &checkerStore() const { return checkers; }
+    BoardGeometry geometry() const { return { boardLeft, boardTop, boardSize, boardCells }; }
+    BoardSnapshot snapshot() const { return { geometry(), checkers }; }
+    int getCheckerCount() const { return checkers.size(); }
+    // Снимок фиксированного размера для истории ходов; false, если шашек больше GameState::MAX_PIECES
+    bool saveState(GameState &state, Side toMove) const;
+    // Возвращает партию к снимку (на текущей доске)
+    void restoreState(const GameState &state);
+    bool isCheckerAlive(int index) const {
+        return index >= 0 && index < checkers.size() && checkers.isAlive(index);
+    }
+    float cellSize() const { return boardSize / boardCells; }
+    float checkerRadius() const { return cellSize() * 0.4f; }
+
+private:
+    CheckerStore checkers;
+    QString winnerColor;
+    bool gameOver;
+    BotDifficulty botDifficulty; // ДОБАВИТЬ ЭТУ СТРОКУ
+
+    // Сохраняем исходные позиции шашек относительно доски
+    QVector<QPointF> initialPositions;
+
+    // Позиции шашек до последнего вызова update() — для интерполяции при отрисовке
+    QVector<float> prevX;
+    QVector<float> prevY;
+    void syncPreviousPositions();
+
+    // Broadphase столкновений; перестраивается целиком только при смене
+    // геометрии или телепортации шашек, в остальное время — инкрементально
+    SpatialGrid grid;
+    bool gridDirty;
+    void rebuildGrid();
+    // Пары-кандидаты текущего шага (буферы переиспользуются между шагами)
+    QVector<int> contactA;
+    QVector<int> contactB;
+
+    float length(const QPointF &v) const;
+    BotMove runShotSearch(Side botSide, int budget, const std::atomic<bool> *cancel,
+                          QVector<BotMove> *top, int topCount) const;
+    bool isOffBoard(float x, float y, float radius) const;
+    void handleCollisions(float travel);
+};
+
+#endif // GAMELOGIC_H
@@ -0,0 +1,100 @@
+#include "gamestate.h"
+
+bool GameState::capture(const CheckerStore &pieces, const BoardGeometry &board, Side sideToMove)
+{
+    const int n = pieces.size();
+    if (n > MAX_PIECES) return false;
+
+    geometry = board;
+    count = n;
+    toMove = sideToMove;
+    aliveBits = 0;
+    for (int i = 0; i < n; ++i) {
+        x[i] = pieces.x[i];
+        y[i] = pieces.y[i];
+        vx[i] = pieces.vx[i];
+        vy[i] = pieces.vy[i];
+        side[i] = pieces.side[i];
+        if (pieces.isAlive(i)) aliveBits |= quint32(1) << i;
+    }
+    return true;
+}
+
+void GameState::restore(CheckerStore &pieces, const BoardGeometry &board) const
+{
+    // Доска могла измениться (окно), поэтому позиции — в долях размера доски.
+    // Массивы того же размера, что у доски, перезаписываются на месте
+    const float scale = board.size / geometry.size;
+    pieces.x.resize(count);
+    pieces.y.resize(count);
+    pieces.vx.resize(count);
+    pieces.vy.resize(count);
+    pieces.side.resize(count);
+    pieces.aliveBits.resize(count > 0 ? 1 : 0); // MAX_PIECES шашек — одно слово
+    for (int i = 0; i < count; ++i) {
+        pieces.x[i] = board.left + (x[i] - geometry.left) * scale;
+        pieces.y[i] = board.top + (y[i] - geometry.top) * scale;
+        const bool alive = isAlive(i);
+        pieces.vx[i] = alive ? vx[i] * scale : 0.0f;
+        pieces.vy[i] = alive ? vy[i] * scale : 0.0f;
+        pieces.side[i] = side[i];
+    }
+    if (count > 0) pieces.aliveBits[0] = aliveBits;
+}
+
+GameHistory::GameHistory()
+    : first(0), count(0), cursor(0)
+{
+}
+
+void GameHistory::clear()
+{
+    first = 0;
+    count = 0;
+    cursor = 0;
+}
+
+void GameHistory::record(const GameState &state)
+{
+    // Запись после отмены отбрасывает ходы, которые можно было повторить
+    if (count > 0) count = cursor + 1;
+    if (count == CAPACITY) {
+        first = (first + 1) % CAPACITY;
+        count--;
+    }
+    ring[(first + count) % CAPACITY] = state;
+    cursor = count;
+    count++;
+}
+
+const GameState *GameHistory::undo()
+{
+    if (!canUndo()) return nullptr;
+    return &at(--cursor);
+}
+
+const GameState *GameHistory::redo()
+{
+    if (!canRedo()) return nullptr;
+    return &at(++cursor);
+}
+
+const GameState *GameHistory::undoTo(Side side)
+{
+    for (int n = cursor - 1; n >= 0; --n) {
+        if (at(n).toMove != side) continue;
+        cursor = n;
+        return &at(n);
+    }
+    return nullptr;
+}
+
+const GameState *GameHistory::redoTo(Side side)
+{
+    for (int n = cursor + 1; n < count; ++n) {
+        if (at(n).toMove != side) continue;
+        cursor = n;
+        return &at(n);
+    }
+    return nullptr;
+}
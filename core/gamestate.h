@@ -0,0 +1,72 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <type_traits>
+#include "checkerstore.h"
+
+// Снимок партии фиксированного размера (несколько сотен байт) без указателей:
+// копируется memcpy, хранится в массивах без выделения памяти. Рассчитан на
+// обычные партии (до MAX_PIECES шашек); большие доски из бенчмарков в него не
+// помещаются — для них остаются CheckerStore и BoardSnapshot.
+struct GameState
+{
+    static constexpr int MAX_PIECES = 32;
+
+    BoardGeometry geometry;
+    float x[MAX_PIECES];
+    float y[MAX_PIECES];
+    float vx[MAX_PIECES];
+    float vy[MAX_PIECES];
+    Side side[MAX_PIECES];
+    quint32 aliveBits;  // бит i == 1 — шашка i в игре
+    int count;
+    Side toMove;
+
+    // false, если шашек больше MAX_PIECES
+    bool capture(const CheckerStore &pieces, const BoardGeometry &board, Side sideToMove);
+    // Шашки снимка на доске board (позиции пересчитываются, если доска другого размера)
+    void restore(CheckerStore &pieces, const BoardGeometry &board) const;
+
+    bool isAlive(int i) const { return (aliveBits >> i) & 1u; }
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState копируется memcpy");
+
+// История ходов для отмены и повтора: кольцо из CAPACITY снимков на начало
+// каждого хода. Новая запись после отмены отбрасывает ветку повтора; при
+// переполнении затирается самый старый снимок. Память выделена один раз
+// вместе с объектом.
+class GameHistory
+{
+public:
+    static constexpr int CAPACITY = 128;
+
+    GameHistory();
+
+    void clear();
+    // Позиция в начале очередного хода (становится текущей)
+    void record(const GameState &state);
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor + 1 < count; }
+    // Шаг назад/вперёд; nullptr, если некуда
+    const GameState *undo();
+    const GameState *redo();
+    // Назад/вперёд до ближайшей позиции, где ходит side (отмена своего хода
+    // вместе с ответом соперника); nullptr, если такой нет
+    const GameState *undoTo(Side side);
+    const GameState *redoTo(Side side);
+
+    const GameState *current() const { return count > 0 ? &at(cursor) : nullptr; }
+    int size() const { return count; }
+
+private:
+    GameState ring[CAPACITY];
+    int first;   // индекс самого старого снимка в кольце
+    int count;   // снимков в истории
+    int cursor;  // номер текущего снимка от самого старого
+
+    const GameState &at(int n) const { return ring[(first + n) % CAPACITY]; }
+};
+
+#endif // GAMESTATE_H
@@ -0,0 +1,250 @@
+#include "logger.h"
+#include <QFile>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+Q_LOGGING_CATEGORY(lcBoard, "chepaev.board")
+Q_LOGGING_CATEGORY(lcPhysics, "chepaev.physics")
+Q_LOGGING_CATEGORY(lcGame, "chepaev.game")
+Q_LOGGING_CATEGORY(lcBot, "chepaev.bot")
+Q_LOGGING_CATEGORY(lcData, "chepaev.data")
+
+namespace {
+
+const int CAPACITY = 2048;          // записей в кольце (степень двойки)
+const int TEXT_BYTES = 240;         // текст записи в UTF-8, длиннее — обрезается
+const int DRAIN_INTERVAL_MS = 50;   // как часто писатель заглядывает в кольцо
+
+qint64 nowMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Entry {
+    qint64 timeMs;
+    const char *category; // имя категории — статическая строка
+    int level;
+    int length;
+    char text[TEXT_BYTES];
+};
+
+// Ограниченная очередь Вьюкова: много писателей, один читатель. Ячейка
+// свободна для записи номер pos, когда её sequence == pos, и готова к
+// чтению, когда sequence == pos + 1.
+struct Ring {
+    struct Cell {
+        std::atomic<quint64> sequence;
+        Entry entry;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::atomic<quint64> head{ 0 }; // следующая запись
+    quint64 tail = 0;               // следующее чтение (только поток писателя)
+
+    Ring() : cells(new Cell[CAPACITY])
+    {
+        for (int i = 0; i < CAPACITY; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Ячейка для записи или nullptr, если кольцо полно
+    Cell *claim()
+    {
+        quint64 pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[pos & (CAPACITY - 1)];
+            const qint64 diff = qint64(cell.sequence.load(std::memory_order_acquire)) - qint64(pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &cell;
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void publish(Cell *cell, quint64 pos) { cell->sequence.store(pos + 1, std::memory_order_release); }
+
+    bool pop(Entry &out)
+    {
+        Cell &cell = cells[tail & (CAPACITY - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != tail + 1) return false;
+        out = cell.entry;
+        cell.sequence.store(tail + CAPACITY, std::memory_order_release);
+        ++tail;
+        return true;
+    }
+};
+
+struct Sink {
+    Ring ring;
+    QFile file;
+    std::thread writer;
+    std::mutex mutex;              // только для сна писателя и запуска/остановки
+    std::condition_variable wake;
+    std::atomic<bool> running{ false };
+    std::atomic<int> writing{ 0 };  // потоков внутри write(): stop ждёт, пока они допишут
+    bool stopping = false;
+    std::atomic<quint64> dropped{ 0 };      // с прошлой выгрузки (для строки в журнале)
+    std::atomic<quint64> droppedTotal{ 0 }; // за всё время (Logger::dropped)
+    qint64 startMs = 0;
+
+    void drain()
+    {
+        static const char LEVELS[] = { 'D', 'I', 'W' };
+        Entry e;
+        QByteArray out;
+        while (ring.pop(e)) {
+            const qint64 t = e.timeMs - startMs;
+            out += QByteArray::number(t / 1000) + '.' + QByteArray::number(t % 1000 + 1000).mid(1);
+            out += ' ';
+            out += LEVELS[e.level];
+            out += ' ';
+            out += e.category;
+            out += ": ";
+            out.append(e.text, e.length);
+            out += '\n';
+        }
+        const quint64 lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0) out += "-- буфер журнала переполнен, потеряно записей: " + QByteArray::number(lost) + '\n';
+        if (!out.isEmpty()) {
+            file.write(out);
+            file.flush();
+        }
+    }
+
+    void loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            lock.unlock();
+            drain();
+            lock.lock();
+            wake.wait_for(lock, std::chrono::milliseconds(DRAIN_INTERVAL_MS), [this] { return stopping; });
+        }
+        lock.unlock();
+        drain();
+    }
+};
+
+Sink &sink()
+{
+    static Sink s;
+    return s;
+}
+
+} // namespace
+
+bool Logger::start(const QString &path)
+{
+    Sink &s = sink();
+    if (s.running.load()) return true;
+
+    s.file.setFileName(path);
+    if (!s.file.open(QIODevice::WriteOnly | QIODevice::Append)) return false;
+    s.startMs = nowMs();
+    s.stopping = false;
+    s.writer = std::thread([&s] { s.loop(); });
+    s.running.store(true, std::memory_order_release);
+    return true;
+}
+
+void Logger::stop()
+{
+    Sink &s = sink();
+    if (!s.running.exchange(false)) return;
+    // Записи, начатые до остановки, должны попасть в последнюю выгрузку
+    while (s.writing.load() > 0) std::this_thread::yield();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.stopping = true;
+    }
+    s.wake.notify_one();
+    s.writer.join();
+    s.file.close();
+}
+
+bool Logger::isRunning()
+{
+    return sink().running.load(std::memory_order_acquire);
+}
+
+quint64 Logger::dropped()
+{
+    return sink().droppedTotal.load(std::memory_order_relaxed);
+}
+
+void Logger::write(const QLoggingCategory &category, Level level, const QString &text)
+{
+    Sink &s = sink();
+    s.writing.fetch_add(1);
+    if (!s.running.load()) {
+        s.writing.fetch_sub(1, std::memory_order_release);
+        // Журнал не запущен — как раньше, через обработчик Qt
+        QMessageLogger logger(nullptr, 0, nullptr, category.categoryName());
+        if (level == Warning) logger.warning().noquote() << text;
+        else if (level == Info) logger.info().noquote() << text;
+        else logger.debug().noquote() << text;
+        return;
+    }
+
+    Ring::Cell *cell = s.ring.claim();
+    if (!cell) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        s.droppedTotal.fetch_add(1, std::memory_order_relaxed);
+        s.writing.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+    // Номер ячейки — из её sequence (пока ячейка наша, он не меняется)
+    const quint64 pos = cell->sequence.load(std::memory_order_relaxed);
+    Entry &e = cell->entry;
+    const QByteArray utf8 = text.toUtf8();
+    e.timeMs = nowMs();
+    e.category = category.categoryName();
+    e.level = level;
+    int length = qMin(int(utf8.size()), TEXT_BYTES);
+    if (length < utf8.size()) {
+        while (length > 0 && (utf8[length] & 0xC0) == 0x80) --length; // не резать символ UTF-8
+    }
+    e.length = length;
+    std::memcpy(e.text, utf8.constData(), length);
+    Ring::publish(cell, pos);
+    s.writing.fetch_sub(1, std::memory_order_release);
+}
+
+bool LogSite::admit()
+{
+    const qint64 now = nowMs();
+    qint64 start = windowStart.load(std::memory_order_relaxed);
+    if (start < 0 || now - start >= 1000) {
+        // Новая секунда: окно сбрасывает тот, кто успел первым
+        if (windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            inWindow.store(0, std::memory_order_relaxed);
+        }
+    }
+    if (inWindow.fetch_add(1, std::memory_order_relaxed) < Logger::RATE_LIMIT) return true;
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+LogRecord::LogRecord(const QLoggingCategory &category_, Logger::Level level_, int suppressed)
+    : category(category_), level(level_)
+{
+    debug.emplace(&text);
+    if (suppressed > 0) {
+        debug->nospace() << "(пропущено похожих: " << suppressed << ") ";
+        debug->space();
+    }
+}
+
+LogRecord::~LogRecord()
+{
+    debug.reset(); // QDebug дописывает text при уничтожении
+    if (text.endsWith(QLatin1Char(' '))) text.chop(1);
+    Logger::write(category, level, text);
+}
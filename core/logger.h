@@ -0,0 +1,99 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QString>
+#include <atomic>
+#include <optional>
+
+// Журнал игры: категории QLoggingCategory, асинхронная запись в файл.
+//
+//     logDebug(lcGame) << "Выстрел по шашке" << index << "сила:" << force;
+//
+// Аргументы форматируются, только если категория включена (правила
+// QT_LOGGING_RULES) и место вызова не упёрлось в ограничение частоты:
+// с одной строки кода — не больше RATE_LIMIT записей в секунду, остальные
+// отбрасываются и в следующей записи отмечается, сколько их было. Готовый
+// текст кладётся в кольцевой буфер без блокировок; метку времени, уровень
+// и категорию дописывает и сбрасывает в файл фоновый поток. Если буфер
+// полон, запись теряется (счётчик dropped).
+//
+// Пока журнал не запущен (утилиты, замеры), записи идут в обычный
+// обработчик сообщений Qt. Отладочные записи (logDebug) в сборке без
+// отладки (QT_NO_DEBUG) вырезаются целиком; вернуть их — CHEPAEV_DEBUG_LOG.
+
+Q_DECLARE_LOGGING_CATEGORY(lcBoard)    // доска и её геометрия
+Q_DECLARE_LOGGING_CATEGORY(lcPhysics)  // движение и вылет шашек
+Q_DECLARE_LOGGING_CATEGORY(lcGame)     // удары и конец партии
+Q_DECLARE_LOGGING_CATEGORY(lcBot)      // выбор хода бота
+Q_DECLARE_LOGGING_CATEGORY(lcData)     // файлы: книга, веса, статистика
+
+class Logger
+{
+public:
+    enum Level { Debug, Info, Warning };
+
+    static constexpr int RATE_LIMIT = 20; // записей в секунду с одного места вызова
+
+    // Запускает фоновую запись в path (дописывает в конец); false, если файл не открылся
+    static bool start(const QString &path);
+    // Дописывает всё накопленное и останавливает поток
+    static void stop();
+    static bool isRunning();
+    // Потеряно записей из-за переполнения буфера (за всё время работы)
+    static quint64 dropped();
+
+    // Готовая запись (вызывается из LogRecord)
+    static void write(const QLoggingCategory &category, Level level, const QString &text);
+};
+
+// Ограничение частоты для одного места вызова (статическое в макросе)
+class LogSite
+{
+public:
+    // true — запись пропускается; иначе она отброшена и посчитана
+    bool admit();
+    // Сколько записей отброшено с прошлой пропущенной (и сброс счётчика)
+    int takeSuppressed() { return suppressed.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<qint64> windowStart{ -1 }; // начало текущей секунды, мс
+    std::atomic<int> inWindow{ 0 };
+    std::atomic<int> suppressed{ 0 };
+};
+
+// Одна запись: собирается через QDebug, в деструкторе уходит в Logger
+class LogRecord
+{
+public:
+    LogRecord(const QLoggingCategory &category, Logger::Level level, int suppressed);
+    ~LogRecord();
+
+    LogRecord(const LogRecord &) = delete;
+    LogRecord &operator=(const LogRecord &) = delete;
+
+    QDebug &stream() { return *debug; }
+
+private:
+    const QLoggingCategory &category;
+    Logger::Level level;
+    QString text;
+    std::optional<QDebug> debug; // пишет в text; сбрасывается до отправки
+};
+
+#define CHEPAEV_LOG(category, enabled, level) \
+    for (bool logOn_ = category().enabled(); logOn_; logOn_ = false) \
+        for (LogSite &logSite_ = []() -> LogSite & { static LogSite site; return site; }(); \
+             logOn_ && logSite_.admit(); logOn_ = false) \
+            LogRecord(category(), level, logSite_.takeSuppressed()).stream()
+
+#if defined(QT_NO_DEBUG) && !defined(CHEPAEV_DEBUG_LOG)
+#define logDebug(category) while (false) QMessageLogger().noDebug()
+#else
+#define logDebug(category) CHEPAEV_LOG(category, isDebugEnabled, Logger::Debug)
+#endif
+#define logInfo(category) CHEPAEV_LOG(category, isInfoEnabled, Logger::Info)
+#define logWarning(category) CHEPAEV_LOG(category, isWarningEnabled, Logger::Warning)
+
+#endif // LOGGER_H
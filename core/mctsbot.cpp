@@ -0,0 +1,451 @@
+#include "mctsbot.h"
+#include "analyticsim.h"
+#include "workpool.h"
+#include "shotcache.h"
+#include "trace.h"
+#include "evaluator.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+const float PI = 3.14159265f;
+
+// Грубая сетка ударов: смещения прицела и силы (в порядке раскрытия)
+const float AIM_OFFSETS_DEG[] = { 0.0f, -4.0f, 4.0f, -9.0f, 9.0f };
+const float POWERS[] = { 280.0f, 400.0f, 160.0f, 540.0f };
+const int TARGETS_PER_PIECE = 2;
+
+const float REUSE_TOLERANCE = 0.5f; // px: позиции считаются совпавшими
+
+const int MAX_LEAF_BATCH = 32;
+
+const qint64 ROUND_NS = 5 * 1000 * 1000; // время одного круга по деревьям
+
+struct Action {
+    int checker;
+    float fx;
+    float fy;
+};
+
+struct Node {
+    CheckerStore state;       // позиция после удара, приведшего в узел
+    quint64 hash;             // BoardHash позиции
+    Side toMove;
+    int parent;
+    Action action;            // удар, приведший в узел
+    std::vector<int> children;
+    std::vector<Action> coarse; // непробованные варианты грубой сетки (с конца)
+    bool coarseReady;
+    int visits;
+    double valueSum;          // с точки зрения стороны, сделавшей удар в узел
+    bool terminal;
+};
+
+bool isTerminal(const CheckerStore &s)
+{
+    return s.aliveCount(Side::White) == 0 || s.aliveCount(Side::Black) == 0;
+}
+
+bool samePosition(const CheckerStore &a, const CheckerStore &b)
+{
+    if (a.size() != b.size() || a.aliveBits != b.aliveBits) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (!a.isAlive(i)) continue;
+        if (std::fabs(a.x[i] - b.x[i]) > REUSE_TOLERANCE) return false;
+        if (std::fabs(a.y[i] - b.y[i]) > REUSE_TOLERANCE) return false;
+    }
+    return true;
+}
+
+// Ближайшие живые враги шашки i (не больше count)
+int nearestEnemies(const CheckerStore &s, int i, int *out, int count)
+{
+    const Side enemy = opponentOf(s.side[i]);
+    float bestD2[TARGETS_PER_PIECE];
+    int found = 0;
+    for (int j = 0; j < s.size(); ++j) {
+        if (s.side[j] != enemy || !s.isAlive(j)) continue;
+        const float dx = s.x[j] - s.x[i];
+        const float dy = s.y[j] - s.y[i];
+        const float d2 = dx * dx + dy * dy;
+        int k;
+        if (found < count) k = found++;
+        else if (d2 < bestD2[count - 1]) k = count - 1;
+        else continue;
+        while (k > 0 && bestD2[k - 1] > d2) {
+            bestD2[k] = bestD2[k - 1];
+            out[k] = out[k - 1];
+            --k;
+        }
+        bestD2[k] = d2;
+        out[k] = j;
+    }
+    return found;
+}
+
+Action aimed(const CheckerStore &s, int checker, int target, float offsetDeg, float power)
+{
+    const float angle = std::atan2(s.y[target] - s.y[checker], s.x[target] - s.x[checker])
+                        + offsetDeg * PI / 180.0f;
+    return { checker, std::cos(angle) * power, std::sin(angle) * power };
+}
+
+} // namespace
+
+struct MctsBot::Tree
+{
+    std::vector<Node> nodes;
+    int root = -1;
+    BoardGeometry geometry = { 0, 0, 0, 0 };
+    QRandomGenerator rng;
+    Side botSide = Side::White; // чьи удары разыгрываются с MctsConfig::forceScale
+    CheckerStore scratch;
+    std::vector<CheckerStore> leaves; // позиции после розыгрышей пачки листьев
+    int iterations = 0;
+    int shots = 0; // разыгранных ударов (раскрытия и розыгрыши)
+
+    void clear() { nodes.clear(); root = -1; }
+
+    int addNode(const CheckerStore &state, quint64 hash, Side toMove, int parent, const Action &action)
+    {
+        Node n;
+        n.state = state;
+        n.hash = hash;
+        n.toMove = toMove;
+        n.parent = parent;
+        n.action = action;
+        n.coarseReady = false;
+        n.visits = 0;
+        n.valueSum = 0.0;
+        n.terminal = isTerminal(state);
+        nodes.push_back(std::move(n));
+        return int(nodes.size()) - 1;
+    }
+
+    // Варианты грубой сетки в порядке раскрытия: сначала прямой прицел
+    // средней силой для каждой шашки, затем остальные силы и смещения
+    void buildCoarse(Node &n)
+    {
+        n.coarseReady = true;
+        const CheckerStore &s = n.state;
+        for (int o = int(std::size(AIM_OFFSETS_DEG)) - 1; o >= 0; --o) {
+            for (int p = int(std::size(POWERS)) - 1; p >= 0; --p) {
+                for (int i = s.size() - 1; i >= 0; --i) {
+                    if (s.side[i] != n.toMove || !s.isAlive(i)) continue;
+                    int targets[TARGETS_PER_PIECE];
+                    const int found = nearestEnemies(s, i, targets, TARGETS_PER_PIECE);
+                    for (int t = found - 1; t >= 0; --t) {
+                        n.coarse.push_back(aimed(s, i, targets[t], AIM_OFFSETS_DEG[o], POWERS[p]));
+                    }
+                }
+            }
+        }
+    }
+
+    // Уточнение: небольшое отклонение угла и силы от лучшего ребёнка
+    Action refine(const Node &n)
+    {
+        int best = n.children.front();
+        for (int c : n.children) {
+            if (nodes[c].visits > nodes[best].visits) best = c;
+        }
+        const Action &a = nodes[best].action;
+        const float power = std::hypot(a.fx, a.fy);
+        const float angle = std::atan2(a.fy, a.fx)
+                            + float(rng.generateDouble() - 0.5) * 6.0f * PI / 180.0f;
+        const float newPower = power * float(0.9 + 0.2 * rng.generateDouble());
+        return { a.checker, std::cos(angle) * newPower, std::sin(angle) * newPower };
+    }
+
+    int expand(int index, const AnalyticSimulator &sim, const MctsConfig &cfg, ShotCache *cache)
+    {
+        if (!nodes[index].coarseReady) buildCoarse(nodes[index]);
+
+        Node &n = nodes[index];
+        const int count = int(n.children.size());
+        Action action;
+        if (!n.coarse.empty() && (count < 4 || count % 3 != 2)) {
+            action = n.coarse.back();
+            n.coarse.pop_back();
+        } else if (count > 0) {
+            action = refine(n);
+        } else {
+            return -1; // ходить нечем
+        }
+
+        // Действие хранится без множителя: его применит BotPlayer
+        scratch.assign(n.state);
+        const float scale = n.toMove == botSide ? cfg.forceScale : 1.0f;
+        const QPointF force(action.fx * scale, action.fy * scale);
+        if (cache) cache->simulateShot(sim, scratch, n.hash, action.checker, force);
+        else sim.simulateShot(scratch, action.checker, force);
+        shots++;
+        const quint64 hash = BoardHash::advance(n.hash, n.state, scratch);
+        const Side next = opponentOf(n.toMove);
+        const int child = addNode(scratch, hash, next, index, action);
+        nodes[index].children.push_back(child);
+        return child;
+    }
+
+    int select(int index, float exploration) const
+    {
+        const Node &n = nodes[index];
+        const float logN = std::log(float(qMax(1, n.visits)));
+        int best = -1;
+        float bestScore = -1.0f;
+        for (int c : n.children) {
+            const Node &child = nodes[c];
+            const float q = float(child.valueSum / child.visits);
+            const float score = q + exploration * std::sqrt(logN / child.visits);
+            if (score > bestScore) { bestScore = score; best = c; }
+        }
+        return best;
+    }
+
+    // Быстрая политика: случайная шашка бьёт в ближайшего врага с разбросом.
+    // Позиция после розыгрыша — в out, возвращает, чей ход в ней
+    Side rollout(int index, int count, const AnalyticSimulator &sim, CheckerStore &out)
+    {
+        out.assign(nodes[index].state);
+        Side side = nodes[index].toMove;
+        for (int k = 0; k < count && !isTerminal(out); ++k) {
+            int own[64];
+            int ownCount = 0;
+            for (int i = 0; i < out.size() && ownCount < 64; ++i) {
+                if (out.side[i] == side && out.isAlive(i)) own[ownCount++] = i;
+            }
+            const int checker = own[rng.bounded(ownCount)];
+            int target;
+            if (nearestEnemies(out, checker, &target, 1) == 1) {
+                const float offset = float(rng.generateDouble() - 0.5) * 12.0f;
+                const float power = 160.0f + float(rng.generateDouble()) * 380.0f;
+                const Action a = aimed(out, checker, target, offset, power);
+                sim.simulateShot(out, a.checker, QPointF(a.fx, a.fy));
+                shots++;
+            }
+            side = opponentOf(side);
+        }
+        return side;
+    }
+
+    // Посещения пути от узла до корня (delta = -1 снимает виртуальные)
+    void addVisits(int index, int delta)
+    {
+        for (int i = index; i >= 0; i = nodes[i].parent) nodes[i].visits += delta;
+    }
+
+    void backpropagate(int index, float valueForWhite)
+    {
+        for (int i = index; i >= 0; i = nodes[i].parent) {
+            Node &n = nodes[i];
+            const Side mover = opponentOf(n.toMove);
+            n.visits++;
+            n.valueSum += (mover == Side::White) ? valueForWhite : 1.0f - valueForWhite;
+        }
+    }
+
+    // Спуск от корня с раскрытием не больше одного узла, возвращает лист
+    int descend(const AnalyticSimulator &sim, const MctsConfig &cfg, ShotCache *cache)
+    {
+        int index = root;
+        for (;;) {
+            const Node &n = nodes[index];
+            if (n.terminal) break;
+            const int allowed = qMax(1, int(cfg.widening * std::sqrt(float(n.visits + 1))));
+            const bool canExpand = !n.coarseReady || !n.coarse.empty() || !n.children.empty();
+            if (int(n.children.size()) < allowed && canExpand) {
+                const int child = expand(index, sim, cfg, cache);
+                if (child >= 0) index = child;
+                break;
+            }
+            if (n.children.empty()) break;
+            index = select(index, cfg.exploration);
+        }
+        return index;
+    }
+
+    // Пачка из cfg.leafBatch итераций: спуски с виртуальным посещением пути
+    // (без ценности, как проигрыш — следующие спуски уходят в другие ветки),
+    // розыгрыши, одна пакетная оценка листьев и обратное распространение
+    void iterate(const AnalyticSimulator &sim, const MctsConfig &cfg, ShotCache *cache,
+                 const PositionEvaluator &evaluator)
+    {
+        const int batch = qBound(1, cfg.leafBatch, MAX_LEAF_BATCH);
+        if (int(leaves.size()) < batch) leaves.resize(batch);
+        int leafIndex[MAX_LEAF_BATCH];
+        const CheckerStore *positions[MAX_LEAF_BATCH];
+        Side toMove[MAX_LEAF_BATCH];
+        float values[MAX_LEAF_BATCH];
+        for (int k = 0; k < batch; ++k) {
+            leafIndex[k] = descend(sim, cfg, cache);
+            addVisits(leafIndex[k], 1);
+            toMove[k] = rollout(leafIndex[k], cfg.rolloutShots, sim, leaves[k]);
+            positions[k] = &leaves[k];
+        }
+        evaluator.evaluateBatch(positions, toMove, batch, geometry, Side::White, values);
+        for (int k = 0; k < batch; ++k) {
+            addVisits(leafIndex[k], -1);
+            backpropagate(leafIndex[k], values[k]);
+        }
+        iterations += batch;
+    }
+
+    // Ищет узел с позицией state на глубине до двух ударов от корня
+    int findReusable(const CheckerStore &state, Side toMove) const
+    {
+        if (root < 0) return -1;
+        std::vector<int> frontier = { root };
+        for (int depth = 0; depth <= 2; ++depth) {
+            std::vector<int> next;
+            for (int i : frontier) {
+                const Node &n = nodes[i];
+                if (n.toMove == toMove && samePosition(n.state, state)) return i;
+                next.insert(next.end(), n.children.begin(), n.children.end());
+            }
+            frontier.swap(next);
+        }
+        return -1;
+    }
+
+    // Поддерево newRoot становится деревом целиком, остальные узлы выбрасываются
+    void reroot(int newRoot)
+    {
+        std::vector<Node> kept;
+        std::vector<int> order = { newRoot };
+        std::vector<int> remap(nodes.size(), -1);
+        for (size_t k = 0; k < order.size(); ++k) {
+            remap[order[k]] = int(k);
+            for (int c : nodes[order[k]].children) order.push_back(c);
+        }
+        kept.reserve(order.size());
+        for (int old : order) {
+            Node n = std::move(nodes[old]);
+            n.parent = (old == newRoot) ? -1 : remap[n.parent];
+            for (int &c : n.children) c = remap[c];
+            kept.push_back(std::move(n));
+        }
+        nodes.swap(kept);
+        root = 0;
+    }
+};
+
+MctsBot::MctsBot(WorkPool *pool_)
+    : pool(pool_ ? pool_ : &WorkPool::shared()), shotCache(nullptr), evaluator(nullptr), stats()
+{
+}
+
+MctsBot::~MctsBot() = default;
+
+void MctsBot::setConfig(const MctsConfig &config)
+{
+    cfg = config;
+    trees.clear();
+}
+
+void MctsBot::reset()
+{
+    for (auto &tree : trees) tree->clear();
+}
+
+BotMove MctsBot::search(const BoardSnapshot &root, Side side, const std::atomic<bool> *cancel)
+{
+    TRACE_ZONE("MctsBot::search");
+    stats = Stats();
+    if (root.pieces.aliveCount(side) == 0) return { -1, QPointF(0, 0), -1000 };
+
+    const int treeCount = cfg.threads > 0 ? qMin(cfg.threads, pool->workerCount())
+                                          : pool->workerCount();
+    if (int(trees.size()) != treeCount) {
+        trees.clear();
+        for (int t = 0; t < treeCount; ++t) {
+            trees.emplace_back(new Tree);
+            trees.back()->rng.seed(cfg.seed * 7919u + quint32(t));
+        }
+    }
+
+    // Продолжаем прошлые деревья, если новая позиция в них есть
+    const quint64 rootHash = BoardHash::compute(root.pieces, root.geometry);
+    for (auto &tree : trees) {
+        tree->botSide = side;
+        tree->iterations = 0;
+        tree->shots = 0;
+        const BoardGeometry &g = root.geometry;
+        const bool sameBoard = tree->geometry.left == g.left && tree->geometry.top == g.top
+                               && tree->geometry.size == g.size && tree->geometry.cells == g.cells;
+        const int reusable = sameBoard ? tree->findReusable(root.pieces, side) : -1;
+        if (reusable >= 0) {
+            tree->reroot(reusable);
+            stats.reusedTrees++;
+            stats.reusedVisits += tree->nodes[0].visits;
+        } else {
+            tree->clear();
+            tree->geometry = g;
+            tree->root = tree->addNode(root.pieces, rootHash, side, -1, { -1, 0.0f, 0.0f });
+        }
+    }
+
+    const AnalyticSimulator sim(root.geometry);
+    static const MaterialEvaluator material;
+    const PositionEvaluator &leafEvaluator = evaluator ? *evaluator : material;
+    QElapsedTimer clock;
+    clock.start();
+    const qint64 budgetNs = qint64(double(cfg.budgetMs) * 1e6);
+    auto stopped = [&] {
+        return (cancel && cancel->load(std::memory_order_relaxed)) || clock.nsecsElapsed() >= budgetNs;
+    };
+
+    // Дерево на кусок: деревья не пересекаются, общего состояния нет.
+    // Бюджет раздаём кругами: за круг каждое дерево думает ROUND_NS. Если пул
+    // занят и parallelFor идёт в одном потоке, деревья делят время поровну,
+    // а не первое съедает его целиком
+    do {
+        pool->parallelFor(treeCount, 1, [&](int begin, int end, int) {
+            for (int t = begin; t < end; ++t) {
+                Tree &tree = *trees[t];
+                const qint64 sliceEnd = clock.nsecsElapsed() + ROUND_NS;
+                do {
+                    tree.iterate(sim, cfg, shotCache, leafEvaluator);
+                } while (!stopped() && clock.nsecsElapsed() < sliceEnd);
+            }
+        });
+    } while (!stopped());
+
+    if (cancel && cancel->load()) return { -1, QPointF(0, 0), -1000 };
+
+    // Сводим посещения ходов корня по всем деревьям
+    struct Merged { Action action; int visits; double valueSum; };
+    QVector<Merged> merged;
+    for (auto &tree : trees) {
+        stats.iterations += tree->iterations;
+        stats.shots += tree->shots;
+        stats.nodes += int(tree->nodes.size());
+        for (int c : tree->nodes[tree->root].children) {
+            const Node &child = tree->nodes[c];
+            bool found = false;
+            for (Merged &m : merged) {
+                if (m.action.checker == child.action.checker && m.action.fx == child.action.fx
+                    && m.action.fy == child.action.fy) {
+                    m.visits += child.visits;
+                    m.valueSum += child.valueSum;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) merged.push_back({ child.action, child.visits, child.valueSum });
+        }
+    }
+    stats.trees = treeCount;
+
+    if (merged.isEmpty()) return { -1, QPointF(0, 0), -1000 };
+
+    const Merged *best = &merged.first();
+    for (const Merged &m : merged) {
+        if (m.visits > best->visits
+            || (m.visits == best->visits && m.valueSum > best->valueSum)) best = &m;
+    }
+    stats.value = float(best->valueSum / best->visits);
+    return { best->action.checker, QPointF(best->action.fx, best->action.fy), stats.value };
+}
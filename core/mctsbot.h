@@ -0,0 +1,96 @@
+#ifndef MCTSBOT_H
+#define MCTSBOT_H
+
+#include <QVector>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "checkerstore.h"
+#include "gamelogic.h"
+
+class PositionEvaluator;
+class ShotCache;
+class WorkPool;
+
+// Параметры поиска MCTS
+struct MctsConfig {
+    float budgetMs = 400.0f;   // время на ход, мс
+    int threads = 0;           // независимых деревьев (0 — по числу рабочих пула)
+    int rolloutShots = 2;      // ударов быстрой политики после листа
+    float exploration = 0.5f;  // константа UCT
+    float widening = 2.0f;     // прогрессивное расширение: детей не больше widening * sqrt(visits)
+    int leafBatch = 8;         // листьев за итерацию (до 32), оцениваемых одним evaluateBatch
+    float forceScale = 1.0f;   // множитель силы ударов бота: с ним их сыграет BotPlayer
+    quint32 seed = 1;
+};
+
+// Бот на поиске по дереву Монте-Карло с просмотром на несколько ударов вперёд.
+//
+// Узел — позиция после удара, ребро — удар (шашка + сила). Пространство ударов
+// непрерывное, поэтому у узла сначала раскрываются варианты грубой сетки
+// (прицел в ближайших врагов со смещениями угла и несколькими силами), а по
+// мере роста посещений добавляются уточнения вокруг лучшего ребёнка. Каждый
+// удар разыгрывается AnalyticSimulator до остановки, лист оценивается
+// коротким розыгрышем быстрой политики и оценкой позиции (по умолчанию
+// MaterialEvaluator — материальный баланс, можно подставить обученную модель).
+// Листья идут пачками по leafBatch: спуски пачки расходятся за счёт
+// виртуальных посещений, а оценка всей пачки — один вызов evaluateBatch.
+//
+// Раскрытие узла может брать исход удара из ShotCache: одинаковые удары
+// грубой сетки у корня разных деревьев и в повторяющихся позициях
+// симулируются один раз.
+//
+// Параллельность — по корню: на каждого рабочего пула своё дерево со своим
+// генератором, по истечении бюджета посещения ходов корня суммируются.
+// Деревья сохраняются между вызовами search(): если новая позиция совпадает
+// с одним из узлов на глубине до двух ударов, поддерево становится корнем.
+class MctsBot
+{
+public:
+    struct Stats {
+        int iterations;    // итераций во всех деревьях
+        int shots;         // ударов, разыгранных при поиске (вместе с попаданиями в кэш)
+        int trees;
+        int reusedTrees;   // деревьев, продолживших прошлый поиск
+        int reusedVisits;  // посещений корня, унаследованных от прошлого поиска
+        int nodes;
+        float value;       // оценка выбранного хода, [0, 1]
+    };
+
+    explicit MctsBot(WorkPool *pool = nullptr); // nullptr — общий пул
+    ~MctsBot();
+
+    MctsBot(const MctsBot &) = delete;
+    MctsBot &operator=(const MctsBot &) = delete;
+
+    void setConfig(const MctsConfig &config);
+    const MctsConfig &config() const { return cfg; }
+
+    // Общий кэш исходов ударов для раскрытия узлов (nullptr — без кэша)
+    void setShotCache(ShotCache *cache) { shotCache = cache; }
+
+    // Оценка листьев после розыгрыша (nullptr — MaterialEvaluator).
+    // Вызывается из нескольких потоков одновременно.
+    void setEvaluator(const PositionEvaluator *leafEvaluator) { evaluator = leafEvaluator; }
+
+    // Ход за сторону side в позиции root. При взводе cancel поиск прерывается
+    // и возвращается ход с checkerIndex = -1.
+    BotMove search(const BoardSnapshot &root, Side side, const std::atomic<bool> *cancel = nullptr);
+
+    // Забыть сохранённые деревья (новая партия)
+    void reset();
+
+    const Stats &lastStats() const { return stats; }
+
+private:
+    struct Tree;
+
+    WorkPool *pool;
+    ShotCache *shotCache;
+    const PositionEvaluator *evaluator;
+    MctsConfig cfg;
+    std::vector<std::unique_ptr<Tree>> trees;
+    Stats stats;
+};
+
+#endif // MCTSBOT_H
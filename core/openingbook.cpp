@@ -0,0 +1,204 @@
+#include "openingbook.h"
+#include "logger.h"
+#include <QCoreApplication>
+#include <QtEndian>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const char MAGIC[4] = { 'C', 'H', 'O', 'B' };
+const quint32 VERSION = 2; // 2 — позиции разыграны физикой с учётом шага (Physics)
+const int HEADER_SIZE = 16;
+const int RECORD_HEAD_SIZE = 24;
+
+int recordSizeFor(int pieces)
+{
+    return (RECORD_HEAD_SIZE + 4 * pieces + 7) & ~7;
+}
+
+quint64 aliveMask(const CheckerStore &pieces)
+{
+    return pieces.aliveBits.isEmpty() ? 0 : pieces.aliveBits[0];
+}
+
+quint16 normalize(float v, float origin, float size)
+{
+    const float f = (v - origin) / size;
+    return quint16(qBound(0.0f, std::round(f * 65535.0f), 65535.0f));
+}
+
+float readFloat(const uchar *p)
+{
+    const quint32 bits = qFromLittleEndian<quint32>(p);
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+void writeFloat(uchar *p, float f)
+{
+    quint32 bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    qToLittleEndian<quint32>(bits, p);
+}
+
+} // namespace
+
+OpeningBook::OpeningBook()
+    : data(nullptr), count(0), pieceCount(0), recordSize(0)
+{
+}
+
+OpeningBook::~OpeningBook()
+{
+    close();
+}
+
+bool OpeningBook::open(const QString &path)
+{
+    close();
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    const qint64 fileSize = file.size();
+    const uchar *mapped = fileSize >= HEADER_SIZE ? file.map(0, fileSize) : nullptr;
+    if (!mapped || std::memcmp(mapped, MAGIC, 4) != 0
+        || qFromLittleEndian<quint32>(mapped + 4) != VERSION) {
+        logWarning(lcData) << "Дебютная книга повреждена или устарела:" << path;
+        close();
+        return false;
+    }
+
+    const int entries = int(qFromLittleEndian<quint32>(mapped + 8));
+    const int pieces = int(qFromLittleEndian<quint32>(mapped + 12));
+    if (pieces <= 0 || pieces > 64
+        || HEADER_SIZE + qint64(entries) * recordSizeFor(pieces) > fileSize) {
+        logWarning(lcData) << "Дебютная книга обрезана:" << path;
+        close();
+        return false;
+    }
+
+    data = mapped;
+    count = entries;
+    pieceCount = pieces;
+    recordSize = recordSizeFor(pieces);
+    return true;
+}
+
+void OpeningBook::close()
+{
+    if (data) file.unmap(const_cast<uchar *>(data));
+    if (file.isOpen()) file.close();
+    data = nullptr;
+    count = 0;
+    pieceCount = 0;
+    recordSize = 0;
+}
+
+const uchar *OpeningBook::record(int i) const
+{
+    return data + HEADER_SIZE + qint64(i) * recordSize;
+}
+
+bool OpeningBook::lookup(const BoardSnapshot &position, Side toMove, BotMove &move) const
+{
+    const CheckerStore &pieces = position.pieces;
+    if (!data || pieces.size() != pieceCount) return false;
+
+    const BoardGeometry &g = position.geometry;
+    const quint64 mask = aliveMask(pieces);
+    const quint8 side = quint8(toMove);
+
+    // Первая запись с ключом не меньше (mask, side)
+    int lo = 0;
+    int hi = count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        const uchar *r = record(mid);
+        const quint64 m = qFromLittleEndian<quint64>(r);
+        if (m < mask || (m == mask && r[8] < side)) lo = mid + 1;
+        else hi = mid;
+    }
+
+    const int tolerance = int(TOLERANCE * 65535.0f);
+    for (int i = lo; i < count; ++i) {
+        const uchar *r = record(i);
+        if (qFromLittleEndian<quint64>(r) != mask || r[8] != side) break;
+
+        const uchar *xy = r + RECORD_HEAD_SIZE;
+        bool match = true;
+        for (int p = 0; p < pieceCount && match; ++p) {
+            if (!pieces.isAlive(p)) continue;
+            const int bx = qFromLittleEndian<quint16>(xy + 4 * p);
+            const int by = qFromLittleEndian<quint16>(xy + 4 * p + 2);
+            match = std::abs(bx - normalize(pieces.x[p], g.left, g.size)) <= tolerance
+                    && std::abs(by - normalize(pieces.y[p], g.top, g.size)) <= tolerance;
+        }
+        if (!match) continue;
+
+        move.checkerIndex = r[9];
+        move.force = QPointF(readFloat(r + 12) * g.size, readFloat(r + 16) * g.size);
+        move.score = readFloat(r + 20);
+        return true;
+    }
+    return false;
+}
+
+bool OpeningBook::write(const QString &path, const QVector<Entry> &entries)
+{
+    if (entries.isEmpty()) return false;
+    const int pieces = entries.first().position.pieces.size();
+    for (const Entry &e : entries) {
+        if (e.position.pieces.size() != pieces || pieces > 64) return false;
+    }
+
+    QVector<Entry> sorted = entries;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Entry &a, const Entry &b) {
+        const quint64 ma = aliveMask(a.position.pieces);
+        const quint64 mb = aliveMask(b.position.pieces);
+        return ma != mb ? ma < mb : quint8(a.toMove) < quint8(b.toMove);
+    });
+
+    const int size = recordSizeFor(pieces);
+    QByteArray bytes(HEADER_SIZE + sorted.size() * size, '\0');
+    uchar *out = reinterpret_cast<uchar *>(bytes.data());
+    std::memcpy(out, MAGIC, 4);
+    qToLittleEndian<quint32>(VERSION, out + 4);
+    qToLittleEndian<quint32>(quint32(sorted.size()), out + 8);
+    qToLittleEndian<quint32>(quint32(pieces), out + 12);
+
+    for (int i = 0; i < sorted.size(); ++i) {
+        const Entry &e = sorted[i];
+        const BoardGeometry &g = e.position.geometry;
+        uchar *r = out + HEADER_SIZE + i * size;
+        qToLittleEndian<quint64>(aliveMask(e.position.pieces), r);
+        r[8] = quint8(e.toMove);
+        r[9] = quint8(e.move.checkerIndex);
+        writeFloat(r + 12, float(e.move.force.x()) / g.size);
+        writeFloat(r + 16, float(e.move.force.y()) / g.size);
+        writeFloat(r + 20, e.move.score);
+        for (int p = 0; p < pieces; ++p) {
+            qToLittleEndian<quint16>(normalize(e.position.pieces.x[p], g.left, g.size), r + RECORD_HEAD_SIZE + 4 * p);
+            qToLittleEndian<quint16>(normalize(e.position.pieces.y[p], g.top, g.size), r + RECORD_HEAD_SIZE + 4 * p + 2);
+        }
+    }
+
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    return f.write(bytes) == bytes.size();
+}
+
+const OpeningBook &OpeningBook::shared()
+{
+    static OpeningBook book;
+    // Инициализация статической переменной потокобезопасна — файл откроется один раз
+    static const bool opened = [] {
+        const QString dir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath()
+                                                         : QString(".");
+        return book.open(dir + "/opening.book");
+    }();
+    Q_UNUSED(opened);
+    return book;
+}
@@ -0,0 +1,64 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include "checkerstore.h"
+#include "gamelogic.h"
+
+// Дебютная книга: заранее найденные глубоким поиском ходы для стартовой
+// позиции и ответов на частые первые удары. Позиции и силы хранятся в долях
+// размера доски, поэтому книга подходит к доске любого размера на экране.
+//
+// Формат файла (little-endian):
+//   заголовок 16 байт: "CHOB", версия, число записей, число шашек;
+//   записи фиксированной длины, отсортированы по (маске живых, стороне):
+//   маска живых (u64), сторона (u8), шашка (u8), 2 байта запаса,
+//   сила fx, fy в долях доски (f32), оценка (f32), затем координаты шашек
+//   x, y (u16, доля доски * 65535), запись выровнена на 8 байт.
+//
+// Файл отображается в память (QFile::map), поиск — двоичный по ключу и
+// сравнение позиций с допуском TOLERANCE.
+class OpeningBook
+{
+public:
+    static constexpr float TOLERANCE = 0.004f; // доля размера доски
+
+    struct Entry {
+        BoardSnapshot position;
+        Side toMove;
+        BotMove move;
+    };
+
+    OpeningBook();
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook &) = delete;
+    OpeningBook &operator=(const OpeningBook &) = delete;
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+    int size() const { return count; }
+
+    // Ход из книги для стороны toMove, если позиция в ней есть
+    bool lookup(const BoardSnapshot &position, Side toMove, BotMove &move) const;
+
+    // Сохраняет записи в файл книги (все позиции — с одним числом шашек)
+    static bool write(const QString &path, const QVector<Entry> &entries);
+
+    // Книга opening.book рядом с исполняемым файлом (пустая, если файла нет)
+    static const OpeningBook &shared();
+
+private:
+    QFile file;
+    const uchar *data;
+    int count;
+    int pieceCount;
+    int recordSize;
+
+    const uchar *record(int i) const;
+};
+
+#endif // OPENINGBOOK_H
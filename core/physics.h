@@ -0,0 +1,58 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <QPointF>
+#include <cmath>
+
+// Единая модель движения шашек: ей подчиняются и игровой цикл
+// (GameLogic::update), и событийный симулятор поиска (AnalyticSimulator),
+// и эвристика бота (GameLogic::evaluateMove).
+//
+// Трение задано на секунду: скорость затухает как v(t) = v0 * e^{-kt},
+// k = -ln(FRICTION_PER_SECOND). Путь за время t равен v0 * travel(t), где
+// travel(t) = (1 - e^{-kt}) / k — точное решение, поэтому исход удара не
+// зависит от длины шага. Пока нет касаний, все шашки проходят один и тот же
+// "путь на единицу скорости", и движение всех шашек линейно по нему.
+// Удар — обмен импульсом вдоль линии центров с упругостью RESTITUTION.
+struct Physics
+{
+    static constexpr float STEP = 0.016f;               // шаг игрового цикла, сек
+    static constexpr float FRICTION_PER_SECOND = 0.28f; // доля скорости, остающаяся через секунду
+    static constexpr float RESTITUTION = 0.8f;          // упругость удара
+    static constexpr float REST_SPEED = 0.5f;           // ниже — шашка остановилась
+
+    // k: затухание скорости e^{-kt}
+    static double decayRate()
+    {
+        static const double k = -std::log(double(FRICTION_PER_SECOND));
+        return k;
+    }
+
+    // Множитель скорости за время t
+    static float velocityDecay(float t) { return static_cast<float>(std::exp(-decayRate() * t)); }
+
+    // Путь шашки с начальной скоростью 1 за время t; полный путь до остановки — 1/k
+    static float travel(float t)
+    {
+        return static_cast<float>((1.0 - std::exp(-decayRate() * t)) / decayRate());
+    }
+
+    // Точка остановки шашки, если она ни во что не врежется
+    static QPointF restPosition(const QPointF &pos, const QPointF &vel)
+    {
+        return pos + vel / decayRate();
+    }
+
+    // Удар шашек i и j, касающихся вдоль единичной нормали (nx, ny) от i к j
+    static void collide(float *vxs, float *vys, int i, int j, float nx, float ny)
+    {
+        const float velocityAlongNormal = (vxs[j] - vxs[i]) * nx + (vys[j] - vys[i]) * ny;
+        const float impulse = -(1.0f + RESTITUTION) * velocityAlongNormal / 2.0f;
+        vxs[i] -= nx * impulse;
+        vys[i] -= ny * impulse;
+        vxs[j] += nx * impulse;
+        vys[j] += ny * impulse;
+    }
+};
+
+#endif // PHYSICS_H
@@ -0,0 +1,49 @@
+#include "shotbatch.h"
+#include "analyticsim.h"
+#include "trace.h"
+#include "workpool.h"
+#include <algorithm>
+
+ShotBatch::ShotBatch(WorkPool *pool_)
+    : pool(pool_ ? pool_ : &WorkPool::shared()), pieceCount(0), aliveWords(0)
+{
+    scratch.resize(pool->workerCount());
+}
+
+void ShotBatch::run(const BoardSnapshot &snapshot, const ShotCandidate *candidates, int count)
+{
+    pieceCount = snapshot.pieces.size();
+    aliveWords = snapshot.pieces.aliveBits.size();
+    outcomes.resize(count);
+    finalX.resize(count * pieceCount);
+    finalY.resize(count * pieceCount);
+    finalAliveBits.resize(count * aliveWords);
+
+    const int whiteBefore = snapshot.pieces.aliveCount(Side::White);
+    const int blackBefore = snapshot.pieces.aliveCount(Side::Black);
+    const AnalyticSimulator sim(snapshot.geometry);
+
+    // Результаты пишутся в заранее размеченные ячейки — рабочие не пересекаются
+    ShotOutcome *outOutcomes = outcomes.data();
+    float *outX = finalX.data();
+    float *outY = finalY.data();
+    quint64 *outAlive = finalAliveBits.data();
+    CheckerStore *buffers = scratch.data();
+
+    pool->parallelFor(count, 4, [&](int begin, int end, int worker) {
+        CheckerStore &pieces = buffers[worker];
+        for (int c = begin; c < end; ++c) {
+            TRACE_ZONE("ShotBatch::candidate");
+            pieces.assign(snapshot.pieces);
+            const AnalyticSimulator::Result r =
+                sim.simulateShot(pieces, candidates[c].checker, candidates[c].force);
+
+            outOutcomes[c] = { whiteBefore - pieces.aliveCount(Side::White),
+                               blackBefore - pieces.aliveCount(Side::Black),
+                               r.time, r.contacts };
+            std::copy(pieces.x.cbegin(), pieces.x.cend(), outX + c * pieceCount);
+            std::copy(pieces.y.cbegin(), pieces.y.cend(), outY + c * pieceCount);
+            std::copy(pieces.aliveBits.cbegin(), pieces.aliveBits.cend(), outAlive + c * aliveWords);
+        }
+    });
+}
@@ -0,0 +1,64 @@
+#ifndef SHOTBATCH_H
+#define SHOTBATCH_H
+
+#include <QPointF>
+#include <QVector>
+#include "checkerstore.h"
+
+class WorkPool;
+
+// Кандидат удара: какой шашкой и с какой силой
+struct ShotCandidate {
+    int checker;
+    QPointF force;
+};
+
+// Итог удара после полной многотельной симуляции до остановки
+struct ShotOutcome {
+    int lostWhite;     // выбито белых
+    int lostBlack;     // выбито чёрных
+    float timeToRest;  // сек до остановки всех шашек
+    int contacts;      // столкновений за удар
+};
+
+// Пакетная симуляция: множество кандидатов из одного снимка доски считаются
+// параллельно на пуле с перехватом работы. У каждого рабочего свой буфер
+// шашек, поэтому на кандидата не выделяется память; буферы результатов
+// переиспользуются между вызовами run().
+class ShotBatch
+{
+public:
+    explicit ShotBatch(WorkPool *pool = nullptr); // nullptr — общий пул
+
+    void run(const BoardSnapshot &snapshot, const ShotCandidate *candidates, int count);
+    void run(const BoardSnapshot &snapshot, const QVector<ShotCandidate> &candidates)
+    {
+        run(snapshot, candidates.constData(), candidates.size());
+    }
+
+    // Результаты последнего run() (действительны до следующего вызова)
+    int size() const { return outcomes.size(); }
+    const ShotOutcome &outcome(int candidate) const { return outcomes[candidate]; }
+    QPointF finalPosition(int candidate, int checker) const
+    {
+        const int k = candidate * pieceCount + checker;
+        return QPointF(finalX[k], finalY[k]);
+    }
+    bool finalAlive(int candidate, int checker) const
+    {
+        const quint64 word = finalAliveBits[candidate * aliveWords + (checker >> 6)];
+        return (word >> (checker & 63)) & 1u;
+    }
+
+private:
+    WorkPool *pool;
+    QVector<CheckerStore> scratch; // рабочая копия доски на каждого рабочего
+    QVector<ShotOutcome> outcomes;
+    QVector<float> finalX;         // [кандидат * pieceCount + шашка]
+    QVector<float> finalY;
+    QVector<quint64> finalAliveBits;
+    int pieceCount;
+    int aliveWords;
+};
+
+#endif // SHOTBATCH_H
@@ -0,0 +1,146 @@
+#include "shotcache.h"
+#include <algorithm>
+
+struct ShotCache::Shard
+{
+    std::mutex mutex;
+    QHash<quint64, int> index;  // ключ -> слот
+    QVector<quint64> keys;
+    QVector<quint8> referenced; // бит обращения для часовой стрелки
+    QVector<float> x;           // [слот * maxPieces + шашка]
+    QVector<float> y;
+    QVector<quint64> aliveBits;
+    QVector<AnalyticSimulator::Result> results;
+    int hand = 0;
+    int used = 0;
+};
+
+ShotCache::ShotCache(int capacity, int maxPieces_, int shards_)
+    : maxPieces(qBound(1, maxPieces_, 64)),
+      shardCount(qMax(1, shards_)),
+      slotsPerShard(qMax(1, capacity / qMax(1, shards_))),
+      shards(new Shard[qMax(1, shards_)]),
+      lookups(0), hits(0), insertions(0), evictions(0)
+{
+    for (int s = 0; s < shardCount; ++s) {
+        Shard &shard = shards[s];
+        shard.index.reserve(slotsPerShard);
+        shard.keys.resize(slotsPerShard);
+        shard.referenced.fill(0, slotsPerShard);
+        shard.x.resize(slotsPerShard * maxPieces);
+        shard.y.resize(slotsPerShard * maxPieces);
+        shard.aliveBits.resize(slotsPerShard);
+        shard.results.resize(slotsPerShard);
+    }
+}
+
+ShotCache::~ShotCache() = default;
+
+ShotCache::Shard &ShotCache::shardFor(quint64 key) const
+{
+    return shards[(key >> 40) % quint64(shardCount)];
+}
+
+bool ShotCache::lookup(quint64 key, CheckerStore &pieces, AnalyticSimulator::Result *result)
+{
+    lookups.fetch_add(1, std::memory_order_relaxed);
+    const int n = pieces.size();
+    if (n > maxPieces) return false;
+
+    Shard &shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto it = shard.index.constFind(key);
+    if (it == shard.index.constEnd()) return false;
+
+    const int slot = it.value();
+    shard.referenced[slot] = 1;
+    const float *sx = shard.x.constData() + slot * maxPieces;
+    const float *sy = shard.y.constData() + slot * maxPieces;
+    float *px = pieces.x.data();
+    float *py = pieces.y.data();
+    float *pvx = pieces.vx.data();
+    float *pvy = pieces.vy.data();
+    for (int i = 0; i < n; ++i) {
+        px[i] = sx[i];
+        py[i] = sy[i];
+        pvx[i] = 0.0f; // после удара всё покоится
+        pvy[i] = 0.0f;
+    }
+    pieces.aliveBits[0] = shard.aliveBits[slot];
+    if (result) *result = shard.results[slot];
+
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ShotCache::store(quint64 key, const CheckerStore &pieces, const AnalyticSimulator::Result &result)
+{
+    const int n = pieces.size();
+    if (n > maxPieces) return;
+
+    Shard &shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.index.contains(key)) return;
+
+    int slot;
+    if (shard.used < slotsPerShard) {
+        slot = shard.used++;
+    } else {
+        // Часовая стрелка: запись с битом обращения получает второй шанс
+        while (shard.referenced[shard.hand]) {
+            shard.referenced[shard.hand] = 0;
+            shard.hand = (shard.hand + 1) % slotsPerShard;
+        }
+        slot = shard.hand;
+        shard.hand = (shard.hand + 1) % slotsPerShard;
+        shard.index.remove(shard.keys[slot]);
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.keys[slot] = key;
+    shard.referenced[slot] = 0;
+    std::copy(pieces.x.cbegin(), pieces.x.cend(), shard.x.begin() + slot * maxPieces);
+    std::copy(pieces.y.cbegin(), pieces.y.cend(), shard.y.begin() + slot * maxPieces);
+    shard.aliveBits[slot] = pieces.aliveBits[0];
+    shard.results[slot] = result;
+    shard.index.insert(key, slot);
+    insertions.fetch_add(1, std::memory_order_relaxed);
+}
+
+AnalyticSimulator::Result ShotCache::simulateShot(const AnalyticSimulator &sim, CheckerStore &pieces,
+                                                  quint64 boardHash, int checker, const QPointF &force)
+{
+    const quint64 key = BoardHash::shotKey(boardHash, checker, force);
+    AnalyticSimulator::Result result;
+    if (lookup(key, pieces, &result)) return result;
+
+    result = sim.simulateShot(pieces, checker, force);
+    store(key, pieces, result);
+    return result;
+}
+
+void ShotCache::clear()
+{
+    for (int s = 0; s < shardCount; ++s) {
+        Shard &shard = shards[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.referenced.fill(0);
+        shard.hand = 0;
+        shard.used = 0;
+    }
+}
+
+ShotCache::Stats ShotCache::stats() const
+{
+    return { lookups.load(std::memory_order_relaxed), hits.load(std::memory_order_relaxed),
+             insertions.load(std::memory_order_relaxed), evictions.load(std::memory_order_relaxed) };
+}
+
+void ShotCache::resetStats()
+{
+    lookups.store(0);
+    hits.store(0);
+    insertions.store(0);
+    evictions.store(0);
+}
@@ -0,0 +1,155 @@
+#ifndef SHOTCACHE_H
+#define SHOTCACHE_H
+
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include "analyticsim.h"
+#include "checkerstore.h"
+
+// Хеш доски в духе Зобриста: XOR ключа геометрии доски и ключей живых шашек,
+// ключ шашки зависит от её номера, стороны и квантованной позиции. Геометрия
+// (края, размер, клетки, а через них и радиус шашек) входит в хеш, чтобы
+// кэш не отдавал исходы, посчитанные на доске другого размера. Покоящиеся
+// позиции, отличающиеся меньше чем на шаг квантования, обычно дают один хеш.
+// Хеш обновляется инкрементально: XOR-ом убирается старый ключ шашки и
+// добавляется новый.
+struct BoardHash
+{
+    static constexpr float POSITION_QUANTUM = 0.5f; // px
+    static constexpr float FORCE_QUANTUM = 1.0f;    // px/s
+
+    static quint64 mix(quint64 z)
+    {
+        z += 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    static qint32 quantize(float v, float quantum)
+    {
+        return static_cast<qint32>(std::floor(v / quantum));
+    }
+
+    static quint64 cellOf(float x, float y)
+    {
+        return (quint64(quint32(quantize(x, POSITION_QUANTUM))) << 32)
+               | quint32(quantize(y, POSITION_QUANTUM));
+    }
+
+    static quint64 cellKey(int index, Side side, quint64 cell)
+    {
+        return mix(mix(quint64(index) * 2 + quint64(side)) ^ cell);
+    }
+
+    static quint64 pieceKey(int index, Side side, float x, float y)
+    {
+        return cellKey(index, side, cellOf(x, y));
+    }
+
+    static quint64 bits(float v)
+    {
+        quint32 b;
+        std::memcpy(&b, &v, sizeof(b));
+        return b;
+    }
+
+    static quint64 geometryKey(const BoardGeometry &g)
+    {
+        return mix(mix((bits(g.left) << 32) | bits(g.top)) ^ ((bits(g.size) << 32) | quint32(g.cells)));
+    }
+
+    static quint64 compute(const CheckerStore &pieces, const BoardGeometry &geometry)
+    {
+        quint64 h = geometryKey(geometry);
+        for (int i = 0; i < pieces.size(); ++i) {
+            if (pieces.isAlive(i)) h ^= pieceKey(i, pieces.side[i], pieces.x[i], pieces.y[i]);
+        }
+        return h;
+    }
+
+    // Хеш позиции after по хешу позиции before: ключи пересчитываются только
+    // у шашек, которые сменили клетку квантования или выбыли
+    static quint64 advance(quint64 h, const CheckerStore &before, const CheckerStore &after)
+    {
+        for (int i = 0; i < before.size(); ++i) {
+            const bool wasAlive = before.isAlive(i);
+            const bool isAlive = after.isAlive(i);
+            if (!wasAlive && !isAlive) continue;
+            const quint64 oldCell = wasAlive ? cellOf(before.x[i], before.y[i]) : 0;
+            const quint64 newCell = isAlive ? cellOf(after.x[i], after.y[i]) : 0;
+            if (wasAlive == isAlive && oldCell == newCell) continue;
+            if (wasAlive) h ^= cellKey(i, before.side[i], oldCell);
+            if (isAlive) h ^= cellKey(i, after.side[i], newCell);
+        }
+        return h;
+    }
+
+    // Ключ удара: позиция плюс (шашка, квантованная сила)
+    static quint64 shotKey(quint64 boardHash, int checker, const QPointF &force)
+    {
+        const quint64 f = (quint64(quint32(quantize(float(force.x()), FORCE_QUANTUM))) << 32)
+                          | quint32(quantize(float(force.y()), FORCE_QUANTUM));
+        return mix(boardHash ^ mix(f ^ (quint64(checker) << 56) ^ 0x5ca1ab1eull));
+    }
+};
+
+// Транспозиционный кэш исходов ударов: ключ удара -> позиция после остановки
+// и итог симуляции. Таблица ограничена по размеру и разбита на шарды со своим
+// мьютексом; внутри шарда вытеснение по часовой стрелке (clock — приближение
+// LRU: запись с битом обращения получает второй шанс). Счётчики попаданий и
+// вытеснений нужны, чтобы подобрать ёмкость.
+class ShotCache
+{
+public:
+    struct Stats {
+        quint64 lookups;
+        quint64 hits;
+        quint64 insertions;
+        quint64 evictions;
+        double hitRate() const { return lookups ? double(hits) / double(lookups) : 0.0; }
+    };
+
+    // capacity — записей всего; позиции с большим числом шашек не кэшируются
+    explicit ShotCache(int capacity = 1 << 16, int maxPieces = 32, int shards = 16);
+    ~ShotCache();
+
+    ShotCache(const ShotCache &) = delete;
+    ShotCache &operator=(const ShotCache &) = delete;
+
+    // При попадании записывает позицию после удара в pieces
+    bool lookup(quint64 key, CheckerStore &pieces, AnalyticSimulator::Result *result = nullptr);
+    void store(quint64 key, const CheckerStore &pieces, const AnalyticSimulator::Result &result);
+
+    // Удар с учётом кэша: pieces — позиция до удара с хешем boardHash
+    AnalyticSimulator::Result simulateShot(const AnalyticSimulator &sim, CheckerStore &pieces,
+                                           quint64 boardHash, int checker, const QPointF &force);
+
+    void clear();
+    Stats stats() const;
+    void resetStats();
+    int capacity() const { return shardCount * slotsPerShard; }
+
+private:
+    struct Shard;
+
+    int maxPieces;
+    int shardCount;
+    int slotsPerShard;
+    std::unique_ptr<Shard[]> shards;
+
+    std::atomic<quint64> lookups;
+    std::atomic<quint64> hits;
+    std::atomic<quint64> insertions;
+    std::atomic<quint64> evictions;
+
+    Shard &shardFor(quint64 key) const;
+};
+
+#endif // SHOTCACHE_H
@@ -0,0 +1,186 @@
+#include "shotheatmap.h"
+#include "workpool.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const int SPLIT_PER_WAVE = 32;   // блоков, делящихся за одну волну уточнения
+const int FIRST_BATCH = 16;      // пачка, пока скорость не замерена
+const int MAX_BATCH = 512;
+
+} // namespace
+
+ShotHeatmap::ShotHeatmap(WorkPool *pool_)
+    : pool(pool_ ? pool_ : &WorkPool::shared()), batch(pool), checkerIndex(-1),
+    minPower(0.0f), maxPower(0.0f), nsPerSample(0.0), sampleCount(0)
+{
+}
+
+void ShotHeatmap::start(const BoardSnapshot &board_, int checker, float minPower_, float maxPower_)
+{
+    clear();
+    if (checker < 0 || checker >= board_.pieces.size() || !board_.pieces.isAlive(checker)) return;
+
+    board = board_;
+    checkerIndex = checker;
+    minPower = minPower_;
+    maxPower = maxPower_;
+    cells.fill(std::numeric_limits<float>::quiet_NaN(), ANGLES * POWERS);
+
+    // Первая волна — грубые блоки (порядок внутри волны не важен)
+    for (int p = 0; p < POWERS; p += BASE_POWER) {
+        for (int a = 0; a < ANGLES; a += BASE_ANGLE) {
+            pending.push_back({ a, p, BASE_ANGLE, BASE_POWER, 0.0f });
+        }
+    }
+}
+
+void ShotHeatmap::clear()
+{
+    checkerIndex = -1;
+    pending.clear();
+    frontier.clear();
+    sampleCount = 0;
+}
+
+float ShotHeatmap::angleOf(float angleCell)
+{
+    return angleCell * 2.0f * 3.14159265f / ANGLES;
+}
+
+float ShotHeatmap::powerOf(float powerCell) const
+{
+    return minPower + powerCell * (maxPower - minPower) / POWERS;
+}
+
+bool ShotHeatmap::advance(float budgetMs)
+{
+    if (!isActive() || isComplete()) return false;
+
+    QElapsedTimer clock;
+    clock.start();
+    const qint64 budgetNs = qint64(double(budgetMs) * 1e6);
+    const Side own = board.pieces.side[checkerIndex];
+    bool changed = false;
+
+    while (clock.nsecsElapsed() < budgetNs) {
+        if (pending.isEmpty()) {
+            splitFrontier();
+            if (pending.isEmpty()) break;
+        }
+
+        // Сколько ударов успеем до конца бюджета (хотя бы один за вызов)
+        const double left = double(budgetNs - clock.nsecsElapsed());
+        int count = nsPerSample > 0.0 ? int(left / nsPerSample) : FIRST_BATCH;
+        count = qMin(qMin(count, MAX_BATCH), int(pending.size()));
+        if (count < 1) {
+            if (changed) break;
+            count = 1;
+        }
+
+        const int first = pending.size() - count;
+        candidates.resize(count);
+        for (int k = 0; k < count; ++k) {
+            const Block &b = pending[first + k];
+            const float angle = angleOf(b.angle + 0.5f * b.angleSize);
+            const float power = powerOf(b.power + 0.5f * b.powerSize);
+            candidates[k] = { checkerIndex, QPointF(std::cos(angle) * power, std::sin(angle) * power) };
+        }
+
+        const qint64 batchStart = clock.nsecsElapsed();
+        batch.run(board, candidates);
+        const double ns = double(clock.nsecsElapsed() - batchStart) / count;
+        nsPerSample = nsPerSample > 0.0 ? 0.5 * (nsPerSample + ns) : ns;
+
+        for (int k = 0; k < count; ++k) {
+            Block b = pending[first + k];
+            const ShotOutcome &o = batch.outcome(k);
+            const int lostOwn = own == Side::White ? o.lostWhite : o.lostBlack;
+            const int lostEnemy = own == Side::White ? o.lostBlack : o.lostWhite;
+            b.value = float(lostEnemy - lostOwn);
+            paint(b);
+            if (b.angleSize > 1 || b.powerSize > 1) frontier.push_back(b);
+        }
+        pending.resize(first);
+        sampleCount += count;
+        changed = true;
+    }
+    return changed;
+}
+
+void ShotHeatmap::paint(const Block &b)
+{
+    for (int p = b.power; p < b.power + b.powerSize; ++p) {
+        for (int a = b.angle; a < b.angle + b.angleSize; ++a) {
+            cells[p * ANGLES + a] = b.value;
+        }
+    }
+}
+
+// Наибольший перепад итога между блоком и клетками вокруг него (угол замкнут)
+float ShotHeatmap::contrast(const Block &b) const
+{
+    float worst = 0.0f;
+    auto check = [&](int a, int p) {
+        if (p < 0 || p >= POWERS) return;
+        const float v = cells[p * ANGLES + (a + ANGLES) % ANGLES];
+        if (!std::isnan(v)) worst = qMax(worst, std::fabs(v - b.value));
+    };
+    for (int a = b.angle - 1; a <= b.angle + b.angleSize; ++a) {
+        check(a, b.power - 1);
+        check(a, b.power + b.powerSize);
+    }
+    for (int p = b.power; p < b.power + b.powerSize; ++p) {
+        check(b.angle - 1, p);
+        check(b.angle + b.angleSize, p);
+    }
+    return worst;
+}
+
+// Волна уточнения: делятся блоки с наибольшим перепадом (при равенстве — крупные)
+void ShotHeatmap::splitFrontier()
+{
+    if (frontier.isEmpty()) return;
+
+    struct Ranked { float contrast; int area; int index; };
+    QVector<Ranked> ranked;
+    ranked.reserve(frontier.size());
+    for (int i = 0; i < frontier.size(); ++i) {
+        const Block &b = frontier[i];
+        ranked.push_back({ contrast(b), b.angleSize * b.powerSize, i });
+    }
+    const int take = qMin(SPLIT_PER_WAVE, int(ranked.size()));
+    std::partial_sort(ranked.begin(), ranked.begin() + take, ranked.end(),
+                      [](const Ranked &x, const Ranked &y) {
+                          return x.contrast != y.contrast ? x.contrast > y.contrast : x.area > y.area;
+                      });
+
+    // Дети в pending в обратном порядке: разбирается он с конца
+    QVector<bool> taken(frontier.size(), false);
+    for (int r = take - 1; r >= 0; --r) {
+        const Block &b = frontier[ranked[r].index];
+        taken[ranked[r].index] = true;
+        const int a1 = b.angleSize > 1 ? b.angleSize / 2 : b.angleSize;
+        const int p1 = b.powerSize > 1 ? b.powerSize / 2 : b.powerSize;
+        for (int pa = 0; pa < (b.powerSize > 1 ? 2 : 1); ++pa) {
+            for (int aa = 0; aa < (b.angleSize > 1 ? 2 : 1); ++aa) {
+                Block c;
+                c.angle = b.angle + aa * a1;
+                c.power = b.power + pa * p1;
+                c.angleSize = aa == 0 ? a1 : b.angleSize - a1;
+                c.powerSize = pa == 0 ? p1 : b.powerSize - p1;
+                c.value = b.value;
+                pending.push_back(c);
+            }
+        }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < frontier.size(); ++i) {
+        if (!taken[i]) frontier[kept++] = frontier[i];
+    }
+    frontier.resize(kept);
+}
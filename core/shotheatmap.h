@@ -0,0 +1,76 @@
+#ifndef SHOTHEATMAP_H
+#define SHOTHEATMAP_H
+
+#include <QVector>
+#include "checkerstore.h"
+#include "shotbatch.h"
+
+class WorkPool;
+
+// Карта качества ударов одной шашки: сетка угол x сила, в каждой клетке —
+// материальный итог полной симуляции (выбито чужих минус выбито своих).
+//
+// Сетка заполняется постепенно. Сначала считаются грубые блоки (один удар на
+// блок BASE_ANGLE x BASE_POWER клеток), затем блоки с наибольшим перепадом
+// итога на границе с соседями делятся пополам по каждой стороне — и так до
+// отдельных клеток. Однородные области делятся в последнюю очередь, поэтому
+// картина верна в общих чертах уже через несколько кадров. Пока блок не
+// поделён, его итог закрашивает все его клетки.
+//
+// Считает advance: пачки ударов идут на пул через ShotBatch, размер пачки
+// подбирается по замеренной скорости, чтобы не выйти из бюджета кадра.
+class ShotHeatmap
+{
+public:
+    static constexpr int ANGLES = 96;     // клеток по углу (полный круг)
+    static constexpr int POWERS = 24;     // клеток по силе
+    static constexpr int BASE_ANGLE = 8;  // размер грубого блока
+    static constexpr int BASE_POWER = 4;
+
+    explicit ShotHeatmap(WorkPool *pool = nullptr); // nullptr — общий пул
+
+    // Новая карта для шашки checker в позиции board, сила в [minPower, maxPower]
+    void start(const BoardSnapshot &board, int checker, float minPower, float maxPower);
+    void clear();
+    // Считает не дольше budgetMs; true, если изменились клетки
+    bool advance(float budgetMs);
+
+    bool isActive() const { return checkerIndex >= 0; }
+    bool isComplete() const { return isActive() && pending.isEmpty() && frontier.isEmpty(); }
+    int checker() const { return checkerIndex; }
+    int samples() const { return sampleCount; }
+
+    // Итог клетки (NaN, пока ни один удар её не покрыл)
+    float value(int angleCell, int powerCell) const { return cells[powerCell * ANGLES + angleCell]; }
+    // Центр клетки: направление удара в радианах (экранные оси) и сила
+    static float angleOf(float angleCell);
+    float powerOf(float powerCell) const;
+
+private:
+    struct Block {
+        int angle;      // первая клетка
+        int power;
+        int angleSize;  // клеток в блоке
+        int powerSize;
+        float value;
+    };
+
+    WorkPool *pool;
+    ShotBatch batch;
+    BoardSnapshot board;
+    int checkerIndex;
+    float minPower;
+    float maxPower;
+    QVector<float> cells;      // [power * ANGLES + angle]
+    QVector<Block> pending;    // ещё не посчитанные
+    QVector<Block> frontier;   // посчитанные, которые можно поделить
+    QVector<ShotCandidate> candidates;
+    double nsPerSample;        // замеренная скорость (с учётом параллельности)
+    int sampleCount;
+
+    void paint(const Block &b);
+    float contrast(const Block &b) const;
+    void splitFrontier();
+};
+
+#endif // SHOTHEATMAP_H
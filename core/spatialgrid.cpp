@@ -0,0 +1,97 @@
+#include "spatialgrid.h"
+#include <cmath>
+
+SpatialGrid::SpatialGrid()
+    : originX(0), originY(0), invCell(1), cell(0), cols(0)
+{
+}
+
+bool SpatialGrid::configure(float left, float top, float size, float cellSize)
+{
+    // Запас в одну ячейку с каждой стороны
+    const float newOriginX = left - cellSize;
+    const float newOriginY = top - cellSize;
+    const int newCols = static_cast<int>(std::ceil(size / cellSize)) + 2;
+
+    if (newOriginX == originX && newOriginY == originY && cellSize == cell && newCols == cols)
+        return false;
+
+    originX = newOriginX;
+    originY = newOriginY;
+    cell = cellSize;
+    invCell = 1.0f / cellSize;
+    cols = qMax(newCols, 3);
+    return true;
+}
+
+void SpatialGrid::clear(int pieceCount)
+{
+    head.fill(-1, cols * cols);
+    occupiedSlot.fill(-1, cols * cols);
+    occupied.clear();
+    next.fill(-1, pieceCount);
+    prev.fill(-1, pieceCount);
+    cellOf.fill(-1, pieceCount);
+}
+
+int SpatialGrid::cellIndex(float x, float y) const
+{
+    // Всё, что за пределами сетки, прижимается к крайним ячейкам
+    int cx = static_cast<int>((x - originX) * invCell);
+    int cy = static_cast<int>((y - originY) * invCell);
+    cx = qBound(0, cx, cols - 1);
+    cy = qBound(0, cy, cols - 1);
+    return cy * cols + cx;
+}
+
+void SpatialGrid::link(int i, int c)
+{
+    const int h = head[c];
+    next[i] = h;
+    prev[i] = -1;
+    if (h >= 0) {
+        prev[h] = i;
+    } else {
+        occupiedSlot[c] = occupied.size();
+        occupied.push_back(c);
+    }
+    head[c] = i;
+    cellOf[i] = c;
+}
+
+void SpatialGrid::unlink(int i)
+{
+    const int c = cellOf[i];
+    if (prev[i] >= 0) next[prev[i]] = next[i];
+    else head[c] = next[i];
+    if (next[i] >= 0) prev[next[i]] = prev[i];
+
+    if (head[c] < 0) {
+        // Ячейка опустела — убираем её из списка занятых (перестановкой с последней)
+        const int slot = occupiedSlot[c];
+        const int last = occupied.last();
+        occupied[slot] = last;
+        occupiedSlot[last] = slot;
+        occupied.removeLast();
+        occupiedSlot[c] = -1;
+    }
+    cellOf[i] = -1;
+}
+
+void SpatialGrid::insert(int i, float x, float y)
+{
+    link(i, cellIndex(x, y));
+}
+
+void SpatialGrid::remove(int i)
+{
+    if (contains(i)) unlink(i);
+}
+
+void SpatialGrid::move(int i, float x, float y)
+{
+    const int c = cellIndex(x, y);
+    if (c == cellOf[i]) return;
+    unlink(i);
+    link(i, c);
+}
@@ -0,0 +1,84 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <QVector>
+
+// Равномерная сетка для broadphase столкновений одинаковых шашек.
+// Сторона ячейки равна диаметру шашки, поэтому касающиеся шашки всегда лежат
+// в одной или соседних ячейках. Ячейки — двусвязные списки индексов шашек,
+// так что перемещение шашки между ячейками стоит O(1) и сетка обновляется
+// инкрементально: за шаг перекладываются только шашки, сменившие ячейку.
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+
+    // Настраивает сетку на прямоугольник [left, left + size]^2 с запасом в одну
+    // ячейку по краям (шашка остаётся в игре, пока частично на доске).
+    // Возвращает true, если геометрия изменилась и сетку нужно перестроить.
+    bool configure(float left, float top, float size, float cellSize);
+
+    void clear(int pieceCount);
+    void insert(int i, float x, float y);
+    void remove(int i);
+    // Переносит шашку в ячейку по новой позиции (если ячейка сменилась)
+    void move(int i, float x, float y);
+
+    bool contains(int i) const { return i < cellOf.size() && cellOf[i] >= 0; }
+
+    // Вызывает fn(i, j) для каждой пары шашек, чьи ячейки отстоят друг от друга
+    // не более чем на ring ячеек по каждой оси (ring = 1 — соседние ячейки;
+    // больше — для быстрых шашек, которые за шаг могут пройти дальше диаметра).
+    // Каждая пара выдаётся ровно один раз.
+    template <typename Fn>
+    void forEachCandidatePair(int ring, Fn &&fn) const;
+
+private:
+    float originX;
+    float originY;
+    float invCell;
+    float cell;
+    int cols;
+
+    QVector<int> head;   // первая шашка в ячейке (-1 — пусто)
+    QVector<int> next;   // следующая шашка в той же ячейке
+    QVector<int> prev;   // предыдущая шашка в той же ячейке
+    QVector<int> cellOf; // ячейка шашки (-1 — не в сетке)
+    QVector<int> occupied; // непустые ячейки (для обхода без просмотра всей сетки)
+    QVector<int> occupiedSlot; // позиция ячейки в occupied (-1 — нет)
+
+    int cellIndex(float x, float y) const;
+    void link(int i, int c);
+    void unlink(int i);
+};
+
+template <typename Fn>
+void SpatialGrid::forEachCandidatePair(int ring, Fn &&fn) const
+{
+    const int cellCount = head.size();
+
+    for (int c : occupied) {
+        const int cx = c % cols;
+        const int cy = c / cols;
+        for (int a = head[c]; a >= 0; a = next[a]) {
+            // Пары внутри ячейки
+            for (int b = next[a]; b >= 0; b = next[b]) fn(a, b);
+
+            // Соседи только "вперёд" (правее в той же строке и все в строках ниже) —
+            // так каждая пара соседних ячеек обходится один раз
+            for (int dy = 0; dy <= ring; ++dy) {
+                const int ny = cy + dy;
+                if (ny >= cols) break;
+                for (int dx = (dy == 0 ? 1 : -ring); dx <= ring; ++dx) {
+                    const int nx = cx + dx;
+                    if (nx < 0 || nx >= cols) continue;
+                    const int nc = ny * cols + nx;
+                    if (nc >= cellCount) continue;
+                    for (int b = head[nc]; b >= 0; b = next[b]) fn(a, b);
+                }
+            }
+        }
+    }
+}
+
+#endif // SPATIALGRID_H
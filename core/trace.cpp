@@ -0,0 +1,169 @@
+#include "trace.h"
+#include <QByteArray>
+#include <QFile>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Trace::enabled{ false };
+
+namespace {
+
+// Поля — атомарные с relaxed-доступом: экспорт читает кольцо, пока
+// владелец в него пишет (на x86 это обычные загрузки и сохранения)
+struct Event {
+    std::atomic<const char *> name;
+    std::atomic<qint64> startNs;
+    std::atomic<qint64> endNs;
+};
+
+struct Buffer {
+    std::unique_ptr<Event[]> events{ new Event[Trace::BUFFER_EVENTS] };
+    std::atomic<quint64> head{ 0 };           // всего записано (позиция следующего)
+    std::atomic<bool> owned{ true };          // есть живой поток-владелец
+    std::atomic<const char *> threadName{ nullptr };
+    int track = 0;                            // tid в файле
+};
+
+struct Registry {
+    std::mutex mutex; // только выдача буферов и экспорт
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::atomic<qint64> originNs{ -1 }; // ноль шкалы времени в файле
+};
+
+Registry &registry()
+{
+    static Registry r;
+    return r;
+}
+
+// Буфер потока; при завершении потока освобождается для следующего
+struct Holder {
+    Buffer *buffer = nullptr;
+    const char *name = nullptr;
+    ~Holder()
+    {
+        if (buffer) buffer->owned.store(false, std::memory_order_release);
+    }
+};
+
+thread_local Holder holder;
+
+Buffer *threadBuffer()
+{
+    if (holder.buffer) return holder.buffer;
+
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const std::unique_ptr<Buffer> &b : r.buffers) {
+        bool expected = false;
+        if (b->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            holder.buffer = b.get();
+            break;
+        }
+    }
+    if (!holder.buffer) {
+        r.buffers.push_back(std::make_unique<Buffer>());
+        r.buffers.back()->track = int(r.buffers.size());
+        holder.buffer = r.buffers.back().get();
+    }
+    holder.buffer->threadName.store(holder.name, std::memory_order_relaxed);
+    return holder.buffer;
+}
+
+void appendEscaped(QByteArray &out, const char *text)
+{
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+}
+
+// Микросекунды с тремя знаками после запятой
+QByteArray micros(qint64 ns)
+{
+    return QByteArray::number(ns / 1000) + '.' + QByteArray::number(ns % 1000 + 1000).mid(1);
+}
+
+} // namespace
+
+void Trace::setEnabled(bool on)
+{
+    if (on) {
+        qint64 unset = -1;
+        registry().originNs.compare_exchange_strong(unset, nowNs());
+    }
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const char *name)
+{
+    holder.name = name;
+    if (holder.buffer) holder.buffer->threadName.store(name, std::memory_order_relaxed);
+}
+
+void Trace::record(const char *name, qint64 startNs, qint64 endNs)
+{
+    Buffer *b = threadBuffer();
+    const quint64 h = b->head.load(std::memory_order_relaxed);
+    Event &e = b->events[h & (BUFFER_EVENTS - 1)];
+    e.name.store(name, std::memory_order_relaxed);
+    e.startNs.store(startNs, std::memory_order_relaxed);
+    e.endNs.store(endNs, std::memory_order_relaxed);
+    b->head.store(h + 1, std::memory_order_release);
+}
+
+bool Trace::exportJson(const QString &path)
+{
+    Registry &r = registry();
+    const qint64 origin = r.originNs.load();
+    QByteArray out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separate = [&] {
+        if (!first) out += ",\n";
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::vector<Event> copy(BUFFER_EVENTS);
+    for (const std::unique_ptr<Buffer> &b : r.buffers) {
+        // Копия последних событий; затем отбрасываются те, что владелец
+        // успел перезаписать, пока шло копирование
+        const quint64 head = b->head.load(std::memory_order_acquire);
+        quint64 from = head > quint64(BUFFER_EVENTS) ? head - BUFFER_EVENTS : 0;
+        for (quint64 i = from; i < head; ++i) {
+            const Event &e = b->events[i & (BUFFER_EVENTS - 1)];
+            Event &c = copy[i & (BUFFER_EVENTS - 1)];
+            c.name.store(e.name.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            c.startNs.store(e.startNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            c.endNs.store(e.endNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const quint64 after = b->head.load(std::memory_order_relaxed);
+        if (after + 1 > quint64(BUFFER_EVENTS)) from = qMax(from, after + 1 - BUFFER_EVENTS);
+
+        separate();
+        const char *threadName = b->threadName.load(std::memory_order_relaxed);
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + QByteArray::number(b->track)
+            + ",\"args\":{\"name\":\"";
+        if (threadName) appendEscaped(out, threadName);
+        else out += "thread " + QByteArray::number(b->track);
+        out += "\"}}";
+
+        for (quint64 i = from; i < head; ++i) {
+            const Event &c = copy[i & (BUFFER_EVENTS - 1)];
+            const qint64 start = c.startNs.load(std::memory_order_relaxed);
+            separate();
+            out += "{\"name\":\"";
+            appendEscaped(out, c.name.load(std::memory_order_relaxed));
+            out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + QByteArray::number(b->track);
+            out += ",\"ts\":" + micros(start - origin);
+            out += ",\"dur\":" + micros(c.endNs.load(std::memory_order_relaxed) - start) + '}';
+        }
+    }
+    out += "\n]}\n";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+    return file.write(out) == out.size();
+}
@@ -0,0 +1,79 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+#include <atomic>
+#include <chrono>
+
+// Трассировка горячих участков в формате Chrome trace (chrome://tracing,
+// ui.perfetto.dev):
+//
+//     void GameLogic::update(float dt)
+//     {
+//         TRACE_ZONE("GameLogic::update");
+//         ...
+//
+// Зона — время жизни объекта до конца блока. Пока запись выключена, зона
+// стоит одной загрузки атомарного флага. Включённая — два чтения монотонных
+// часов и запись в буфер своего потока: кольцо на BUFFER_EVENTS событий
+// без блокировок (пишет только поток-владелец, экспорт лишь читает и
+// отбрасывает то, что успело затереться). Старые события затираются
+// новыми, поэтому в файле — последние события каждого потока. Буфер
+// завершившегося потока достаётся следующему новому (поток поиска бота живёт
+// один ход) вместе с дорожкой в просмотрщике.
+//
+// Имя зоны — строковый литерал: хранится только указатель. С
+// CHEPAEV_NO_TRACE зоны вырезаются из сборки целиком.
+class Trace
+{
+public:
+    static constexpr int BUFFER_EVENTS = 1 << 15; // на поток, степень двойки
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool on);
+    // Подпись дорожки текущего потока (литерал)
+    static void setThreadName(const char *name);
+    // Записанное на этот момент — в JSON Chrome trace; false, если файл не записался
+    static bool exportJson(const QString &path);
+
+    static qint64 nowNs()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+    // Готовая зона (вызывается из TraceZone)
+    static void record(const char *name, qint64 startNs, qint64 endNs);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+class TraceZone
+{
+public:
+    explicit TraceZone(const char *name_)
+        : name(name_), startNs(Trace::isEnabled() ? Trace::nowNs() : -1)
+    {
+    }
+    ~TraceZone()
+    {
+        if (startNs >= 0) Trace::record(name, startNs, Trace::nowNs());
+    }
+
+    TraceZone(const TraceZone &) = delete;
+    TraceZone &operator=(const TraceZone &) = delete;
+
+private:
+    const char *name;
+    qint64 startNs;
+};
+
+#ifdef CHEPAEV_NO_TRACE
+#define TRACE_ZONE(name) do {} while (false)
+#else
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone_, __LINE__)(name)
+#endif
+
+#endif // TRACE_H
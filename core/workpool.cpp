@@ -0,0 +1,122 @@
+#include "workpool.h"
+#include "trace.h"
+
+WorkPool::WorkPool(int threadCount)
+    : queues(threadCount > 0 ? threadCount
+                             : qMax(1, static_cast<int>(std::thread::hardware_concurrency()))),
+    job(nullptr), generation(0), busyWorkers(0), stopping(false)
+{
+    // Рабочий 0 — вызывающий поток, остальным заводим свои потоки
+    for (int w = 1; w < workerCount(); ++w) {
+        threads.emplace_back(&WorkPool::workerLoop, this, w);
+    }
+}
+
+WorkPool::~WorkPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &t : threads) t.join();
+}
+
+WorkPool &WorkPool::shared()
+{
+    static WorkPool pool;
+    return pool;
+}
+
+void WorkPool::parallelFor(int count, int grain, const std::function<void(int, int, int)> &fn)
+{
+    if (count <= 0) return;
+    grain = qMax(1, grain);
+
+    // Пул занят другим вызовом, потоков нет или работы на один кусок — считаем сами
+    std::unique_lock<std::mutex> jobLock(jobMutex, std::try_to_lock);
+    if (!jobLock.owns_lock() || workerCount() == 1 || count <= grain) {
+        for (int begin = 0; begin < count; begin += grain) {
+            fn(begin, qMin(count, begin + grain), 0);
+        }
+        return;
+    }
+
+    // Раздаём куски по очередям по кругу
+    const int workers = workerCount();
+    int k = 0;
+    for (int begin = 0; begin < count; begin += grain, ++k) {
+        Queue &q = queues[k % workers];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.ranges.push_back({ begin, qMin(count, begin + grain) });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        job = &fn;
+        generation++;
+        busyWorkers = workers - 1;
+    }
+    wake.notify_all();
+
+    drain(0);
+
+    // Ждём, пока каждый рабочий закончит с этим заданием
+    std::unique_lock<std::mutex> lock(stateMutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void WorkPool::workerLoop(int worker)
+{
+    Trace::setThreadName("WorkPool");
+    quint64 seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        drain(worker);
+
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (--busyWorkers == 0) done.notify_one();
+    }
+}
+
+void WorkPool::drain(int worker)
+{
+    Range r;
+    while (takeRange(worker, r)) {
+        (*job)(r.begin, r.end, worker);
+    }
+}
+
+bool WorkPool::takeRange(int worker, Range &out)
+{
+    // Своя очередь — с конца (последние куски ещё "тёплые" в кэше)
+    {
+        Queue &own = queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.ranges.empty()) {
+            out = own.ranges.back();
+            own.ranges.pop_back();
+            return true;
+        }
+    }
+
+    // Чужие — с начала
+    const int workers = workerCount();
+    for (int k = 1; k < workers; ++k) {
+        Queue &victim = queues[(worker + k) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            out = victim.ranges.front();
+            victim.ranges.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,63 @@
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include <QVector>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с перехватом работы (work stealing) для пакетных вычислений.
+// Диапазон индексов режется на куски, куски раздаются по очередям рабочих;
+// каждый рабочий берёт куски из своей очереди с конца, а опустошив её —
+// ворует из начала чужих. Вызывающий поток участвует как рабочий 0, так что
+// номер рабочего всегда в [0, workerCount()) и подходит для индексации
+// собственного рабочего буфера.
+class WorkPool
+{
+public:
+    // threads — общее число рабочих вместе с вызывающим (0 — по числу ядер)
+    explicit WorkPool(int threads = 0);
+    ~WorkPool();
+
+    WorkPool(const WorkPool &) = delete;
+    WorkPool &operator=(const WorkPool &) = delete;
+
+    int workerCount() const { return static_cast<int>(queues.size()); }
+
+    // Выполняет fn(begin, end, worker) для кусков [0, count) размером не больше grain
+    // и возвращается, когда обработаны все. Если пул уже занят другим вызовом,
+    // работа выполняется целиком в вызывающем потоке (worker = 0).
+    void parallelFor(int count, int grain, const std::function<void(int, int, int)> &fn);
+
+    // Общий пул процесса
+    static WorkPool &shared();
+
+private:
+    struct Range { int begin; int end; };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<Queue> queues;
+
+    std::mutex jobMutex;        // один parallelFor за раз
+    std::mutex stateMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int, int, int)> *job;
+    quint64 generation;
+    int busyWorkers;
+    bool stopping;
+
+    void workerLoop(int worker);
+    void drain(int worker);
+    bool takeRange(int worker, Range &out);
+};
+
+#endif // WORKPOOL_H
@@ -1,23 +1,58 @@
 #include "gamewidget.h"
+#include "logger.h"
+#include "trace.h"
 #include <QPainter>
 #include <QMouseEvent>
-#include <QRandomGenerator>
-#include <QDebug>
+#include <QKeyEvent>
+#include <QPaintEvent>
+#include <QDir>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QtMath>
 #include <algorithm>
 #include <cmath>
 
+// Пределы силы удара игрока
+static const float PLAYER_MIN_FORCE = 10.0f;
+static const float PLAYER_MAX_FORCE = 450.0f;
+
+// Сила удара игрока по положению мыши: движение "вперёд" от шашки, с
+// множителем и пределом. rawLength — длина до ограничения (слишком слабый
+// рывок ударом не считается).
+static QPointF playerForce(const QPointF &checkerPos, const QPointF &mouse, float *rawLength)
+{
+    const float PLAYER_FORCE_MULT = 3.0f;
+    QPointF rawForce = (mouse - checkerPos) * PLAYER_FORCE_MULT;
+    const float len = std::hypot(rawForce.x(), rawForce.y());
+    if (len > PLAYER_MAX_FORCE) rawForce *= (PLAYER_MAX_FORCE / len);
+    if (rawLength) *rawLength = len;
+    return rawForce;
+}
+
 GameWidget::GameWidget(QWidget *parent)
     : QWidget(parent),
     logic(),
-    gameTimer(this),
+    aimAssist(false),
+    analysisMode(false),
+    heatmapDirty(false),
+    lastFrameNs(0),
+    frameStartNs(0),
+    physicsAccumulator(0.0),
+    renderAlpha(1.0f),
+    frameScheduled(false),
+    runState(RunState::Running),
     dragging(false),
     playerTurn(true),
+    shotInFlight(false),
     selectedChecker(-1),
     menuButtonHovered(false),
-    difficulty(Medium)
+    difficulty(Medium),
+    paintMsAverage(0.0),
+    showPaintTime(false)
 {
     setMinimumSize(600, 600);
     setMouseTracking(true);
+    setFocusPolicy(Qt::StrongFocus); // Ctrl+Z / Ctrl+Shift+Z
 
     // Попытка загрузить фон (тот же ресурс, что используется в меню)
     bgPixmap = QPixmap(":/images/menu_bg.jpg");
@@ -26,12 +61,19 @@ GameWidget::GameWidget(QWidget *parent)
     updateBoardGeometry();
     // initBoard вызываем только при старте (если доска пуста)
     logic.initBoard();
+    recordTurn();
 
-    connect(&gameTimer, &QTimer::timeout, this, &GameWidget::onFrame);
-    gameTimer.start(16); // ~60 FPS
+    // Кадры идут в темпе перерисовок (update), а не по слепому 16-мс таймеру:
+    // после каждой отрисовки планируется следующий onFrame. Когда делать
+    // нечего, цикл останавливается (см. finishFrame и wake)
+    frameClock.start();
+    update();
+    wake();
 
     // Синхронизация сложности в логике
     logic.setBotDifficulty(static_cast<BotDifficulty>(difficulty));
+
+    connect(&bot, &BotWorker::moveReady, this, &GameWidget::onBotMoveReady);
 }
 
 QSize GameWidget::sizeHint() const
@@ -45,6 +87,13 @@ void GameWidget::setBotDifficulty(Difficulty d)
     logic.setBotDifficulty(static_cast<BotDifficulty>(d));
 }
 
+void GameWidget::setAimAssist(bool on)
+{
+    aimAssist = on;
+    if (!on) aimPreview.clear();
+    update();
+}
+
 void GameWidget::updateBoardGeometry()
 {
     int w = width();
@@ -77,56 +126,76 @@ void GameWidget::updateBoardGeometry()
         logic.boardSize = newBoardSize;
     }
 
-    qDebug() << "Геометрия обновлена. Окно:" << w << "x" << h;
-    qDebug() << "Доска:" << logic.boardLeft << logic.boardTop << logic.boardSize;
+    logDebug(lcBoard) << "Геометрия обновлена. Окно:" << w << "x" << h
+                      << "доска:" << logic.boardLeft << logic.boardTop << logic.boardSize;
 }
 
-void GameWidget::paintEvent(QPaintEvent *)
+void GameWidget::paintEvent(QPaintEvent *e)
 {
+    TRACE_ZONE("GameWidget::paintEvent");
+    QElapsedTimer paintClock;
+    paintClock.start();
+
+    // Перерисовывается только область события — части вне её пропускаются
+    const QRegion &dirty = e->region();
+
     QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, true);
 
-    // Рисуем фон (если есть ресурс) — сначала фон, затем доска
-    if (!bgPixmap.isNull()) {
-        p.drawPixmap(rect(), bgPixmap);
-    } else {
-        p.fillRect(rect(), QColor(44, 62, 80));
-    }
+    // Фон и доска — готовый слой (пересобирается только при смене размера
+    // или DPR; геометрию доски обновляет resizeEvent)
+    renderer.drawStatic(&p, dirty, size(), devicePixelRatioF(), bgPixmap, logic);
 
-    // Обновляем геометрию перед отрисовкой (на случай изменения размера)
-    updateBoardGeometry();
-
-    // Рисуем доску и шашки через GameLogic
-    logic.drawBoard(&p);
+    // Шашки с интерполяцией между шагами физики: выбранная игроком и
+    // анализируемая в режиме карты ударов — с кольцом
+    const HudState hud = hudState();
+    renderer.drawPieces(&p, dirty, logic, renderAlpha, hud.selected, hud.highlighted);
 
     // Отрисовка UI: счёт, кнопка меню, индикатор хода и линия прицеливания
-    int whiteCount = logic.getWhiteCheckers().size();
-    int blackCount = logic.getBlackCheckers().size();
 
     // Панель счёта
-    p.setPen(Qt::NoPen);
-    p.setBrush(QColor(0, 0, 0, 160));
-    p.drawRoundedRect(10, 10, 220, 72, 8, 8);
+    if (dirty.intersects(scoreRect())) {
+        p.setPen(Qt::NoPen);
+        p.setBrush(QColor(0, 0, 0, 160));
+        p.drawRoundedRect(scoreRect(), 8, 8);
+
+        p.setPen(Qt::white);
+        p.setFont(QFont("Arial", 12, QFont::Bold));
+        p.setBrush(Qt::white);
+        p.drawEllipse(20, 28, 18, 18);
+        p.drawText(50, 43, QString::fromUtf8("Белые: %1").arg(hud.white));
+
+        p.setBrush(Qt::black);
+        p.drawEllipse(20, 50, 18, 18);
+        p.setPen(Qt::white);
+        p.drawText(50, 65, QString::fromUtf8("Черные: %1").arg(hud.black));
+    }
 
-    p.setPen(Qt::white);
-    p.setFont(QFont("Arial", 12, QFont::Bold));
-    p.setBrush(Qt::white);
-    p.drawEllipse(20, 28, 18, 18);
-    p.drawText(50, 43, QString::fromUtf8("Белые: %1").arg(whiteCount));
+    // Кнопка "В меню"
+    if (dirty.intersects(menuButtonRect())) {
+        p.setPen(Qt::NoPen);
+        p.setBrush(menuButtonHovered ? QColor(255,255,255,250) : QColor(255,255,255,220));
+        p.drawRoundedRect(menuButtonRect(), 8, 8);
+        p.setPen(Qt::black);
+        p.setFont(QFont("Arial", 12, QFont::Bold));
+        p.drawText(menuButtonRect(), Qt::AlignCenter, QString::fromUtf8("В меню"));
+    }
 
-    p.setBrush(Qt::black);
-    p.drawEllipse(20, 50, 18, 18);
-    p.setPen(Qt::white);
-    p.drawText(50, 65, QString::fromUtf8("Черные: %1").arg(blackCount));
+    // Кнопка "Ход назад" — тусклая, если отменять нечего
+    if (dirty.intersects(undoButtonRect())) {
+        p.setPen(Qt::NoPen);
+        p.setBrush(hud.canTakeBack ? QColor(255,255,255,220) : QColor(255,255,255,90));
+        p.drawRoundedRect(undoButtonRect(), 8, 8);
+        p.setPen(hud.canTakeBack ? Qt::black : QColor(0,0,0,120));
+        p.setFont(QFont("Arial", 12, QFont::Bold));
+        p.drawText(undoButtonRect(), Qt::AlignCenter, QString::fromUtf8("Ход назад"));
+    }
 
-    // Кнопка "В меню"
-    QRect menuButtonRect(width() - 140, 12, 128, 40);
-    p.setPen(Qt::NoPen);
-    p.setBrush(menuButtonHovered ? QColor(255,255,255,250) : QColor(255,255,255,220));
-    p.drawRoundedRect(menuButtonRect, 8, 8);
-    p.setPen(Qt::black);
-    p.setFont(QFont("Arial", 12, QFont::Bold));
-    p.drawText(menuButtonRect, Qt::AlignCenter, QString::fromUtf8("В меню"));
+    // Карта ударов режима анализа — поверх шашек
+    if (analysisMode) drawHeatmap(p);
+
+    // Подсказка прицела — под линией прицеливания
+    if (aimAssist && dragging) drawAimPreview(p);
 
     // Линия прицеливания (если игрок тянет)
     if (dragging && selectedChecker >= 0 && logic.isCheckerAlive(selectedChecker)) {
@@ -149,38 +218,99 @@ void GameWidget::paintEvent(QPaintEvent *)
     }
 
     // Индикатор хода
-    QString turnText = playerTurn ? QString::fromUtf8("🎯 Ваш ход (белые)") : QString::fromUtf8("🤖 Ход противника (черные)");
-    QRect turnRect(width() / 2 - 160, height() - 70, 320, 44);
-    p.setPen(Qt::NoPen);
-    p.setBrush(QColor(0,0,0,160));
-    p.drawRoundedRect(turnRect, 10, 10);
-    p.setPen(Qt::white);
-    p.setFont(QFont("Arial", 14, QFont::Bold));
-    p.drawText(turnRect, Qt::AlignCenter, turnText);
+    if (dirty.intersects(turnRect())) {
+        QString turnText = hud.turn == 0 ? QString::fromUtf8("🎯 Ваш ход (белые)")
+                           : hud.turn == 1 ? QString::fromUtf8("🤖 Противник думает…")
+                                           : QString::fromUtf8("🤖 Ход противника (черные)");
+        p.setPen(Qt::NoPen);
+        p.setBrush(QColor(0,0,0,160));
+        p.drawRoundedRect(turnRect(), 10, 10);
+        p.setPen(Qt::white);
+        p.setFont(QFont("Arial", 14, QFont::Bold));
+        p.drawText(turnRect(), Qt::AlignCenter, turnText);
+    }
+
+    // Время отрисовки кадра (F3): скользящее среднее по последним кадрам
+    const double paintMs = paintClock.nsecsElapsed() / 1e6;
+    paintMsAverage = paintMsAverage > 0.0 ? 0.95 * paintMsAverage + 0.05 * paintMs : paintMs;
+    if (showPaintTime) {
+        p.setPen(Qt::white);
+        p.setFont(QFont("Arial", 10));
+        p.drawText(paintTimeRect(), Qt::AlignLeft | Qt::AlignVCenter,
+                   QString::fromUtf8("отрисовка: %1 мс").arg(paintMsAverage, 0, 'f', 2));
+    }
+
+    if (runState == RunState::Running) scheduleFrame();
+}
+
+// Следующий кадр — после того, как текущий отрисован, но не раньше чем через
+// FRAME_INTERVAL_NS от начала прошлого: растровая отрисовка не ждёт кадровой
+// развёртки, и без ограничения цикл крутился бы на всё ядро
+void GameWidget::scheduleFrame()
+{
+    if (frameScheduled) return;
+    frameScheduled = true;
+    const qint64 waitNs = frameStartNs + FRAME_INTERVAL_NS - frameClock.nsecsElapsed();
+    if (waitNs > 0) {
+        QTimer::singleShot(int((waitNs + 999999) / 1000000), Qt::PreciseTimer, this, &GameWidget::onFrame);
+    } else {
+        QMetaObject::invokeMethod(this, &GameWidget::onFrame, Qt::QueuedConnection);
+    }
+}
+
+// Запуск цикла после простоя. Время отсчитывается заново, чтобы первый
+// кадр не получил весь простой разом, — и в состоянии Running, если кадров
+// давно не было (цикл ждал отрисовки, которой не случилось). Частые вызовы
+// из работающего цикла (движение мыши) время не сбрасывают.
+void GameWidget::wake()
+{
+    const qint64 nowNs = frameClock.nsecsElapsed();
+    if (runState == RunState::Idle || nowNs - lastFrameNs > STALLED_FRAME_NS) lastFrameNs = nowNs;
+    runState = RunState::Running;
+    scheduleFrame();
+}
+
+// Нужны ли ещё кадры: шашки в движении или позиция после удара не
+// записана, идёт расчёт подсказки или карты ударов, ход пора отдать боту
+bool GameWidget::hasWork() const
+{
+    return logic.isMoving() || shotInFlight || aimPreview.isBusy()
+        || (heatmap.isActive() && !heatmap.isComplete())
+        || (!playerTurn && !bot.isThinking() && !logic.checkGameOver());
 }
 
 void GameWidget::mousePressEvent(QMouseEvent *e)
 {
     if (e->button() != Qt::LeftButton) return;
 
-    QRect menuButtonRect(width() - 140, 12, 128, 40);
-    if (menuButtonRect.contains(e->pos())) {
+    if (menuButtonRect().contains(e->pos())) {
+        // Незаконченный поиск хода бота больше не нужен
+        bot.cancel();
         emit backToMenuClicked();
         return;
     }
 
+    if (undoButtonRect().contains(e->pos())) {
+        takeBack();
+        return;
+    }
+
+    // В режиме анализа клик выбирает шашку (любой стороны) для карты ударов
+    if (analysisMode) {
+        if (!logic.isMoving()) startHeatmap(logic.getCheckerAtPosition(e->pos()));
+        return;
+    }
+
     if (!playerTurn || logic.isMoving()) return;
 
     selectedChecker = -1;
-    const float cell = logic.boardSize / 8.0f;
-    const float radius = cell * 0.4f;
+    const float radius = logic.checkerRadius();
 
-    const auto& checkers = logic.getCheckers();
+    const CheckersView checkers = logic.checkersView();
     for (int i = 0; i < checkers.size(); ++i) {
-        const auto& c = checkers[i];
-        if (!c->alive || c->color != Qt::white) continue;
+        if (!checkers.isAlive(i) || checkers.side[i] != Side::White) continue;
 
-        float dist = std::hypot(e->pos().x() - c->pos.x(), e->pos().y() - c->pos.y());
+        float dist = std::hypot(e->pos().x() - checkers.x[i], e->pos().y() - checkers.y[i]);
         if (dist <= radius) {
             selectedChecker = i;
             break;
@@ -191,20 +321,29 @@ void GameWidget::mousePressEvent(QMouseEvent *e)
         dragging = true;
         dragStart = logic.getCheckerPosition(selectedChecker);
         currentMouse = e->pos();
-        update();
+        update(aimLineRect());
+        wake(); // кольцо выделения
     }
 }
 
 void GameWidget::mouseMoveEvent(QMouseEvent *e)
 {
-    QRect menuButtonRect(width() - 140, 12, 128, 40);
     bool wasHovered = menuButtonHovered;
-    menuButtonHovered = menuButtonRect.contains(e->pos());
-    if (wasHovered != menuButtonHovered) update();
+    menuButtonHovered = menuButtonRect().contains(e->pos());
+    if (wasHovered != menuButtonHovered) update(menuButtonRect());
 
     if (dragging && selectedChecker >= 0) {
+        // Стираем линию в старом положении и рисуем в новом
+        QRegion line = aimLineRect();
         currentMouse = e->pos();
-        update();
+        line += aimLineRect();
+        // Только запоминаем запрос: считается он в onFrame, сколько успеет за кадр
+        if (aimAssist) {
+            const QPointF force = playerForce(logic.getCheckerPosition(selectedChecker), currentMouse, nullptr);
+            aimPreview.request(logic.snapshot(), selectedChecker, force);
+            wake();
+        }
+        update(line);
     }
 }
 
@@ -213,49 +352,85 @@ void GameWidget::mouseReleaseEvent(QMouseEvent *e)
     if (e->button() != Qt::LeftButton) return;
     if (!(dragging && selectedChecker >= 0)) return;
 
+    // Стираем линию прицеливания и подсказку
+    update(aimLineRect());
+    update(shownPreviewRect);
+    shownPreviewRect = QRect();
     dragging = false;
-
-    QPointF checkerPos = logic.getCheckerPosition(selectedChecker);
+    aimPreview.clear();
 
     // РЕЗЮМЕ: меняем знак направления - теперь движение задаётся движением мыши "вперёд",
     // а не тянением назад. Раньше использовалось checkerPos - e->pos(), теперь e->pos() - checkerPos.
-    QPointF direction = e->pos() - checkerPos;
+    float len = 0.0f;
+    QPointF rawForce = playerForce(logic.getCheckerPosition(selectedChecker), e->pos(), &len);
 
-    // Умеренная сила игрока + пределы
-    const float PLAYER_FORCE_MULT = 3.0f;
-    const float MAX_FORCE = 450.0f;
-    QPointF rawForce = direction * PLAYER_FORCE_MULT;
-    float len = std::hypot(rawForce.x(), rawForce.y());
-    if (len > MAX_FORCE) rawForce *= (MAX_FORCE / len);
-
-    const float MIN_FORCE = 10.0f;
-    if (len >= MIN_FORCE) {
+    if (len >= PLAYER_MIN_FORCE) {
         logic.shoot(selectedChecker, rawForce);
         playerTurn = false; // передаём ход боту
+        shotInFlight = true;
     }
 
     selectedChecker = -1;
-    update();
+    wake();
 }
 
 void GameWidget::resizeEvent(QResizeEvent *event)
 {
     Q_UNUSED(event);
     updateBoardGeometry();
+    // Доска в других координатах — карту ударов строим заново
+    if (heatmap.isActive()) startHeatmap(heatmap.checker());
     update();
+    wake();
 }
 
 void GameWidget::onFrame()
 {
-    // Физический шаг
-    logic.update(0.016f);
+    TRACE_ZONE("GameWidget::onFrame");
+    frameScheduled = false;
+
+    // Реальное прошедшее время по монотонным часам (с ограничением сверху,
+    // чтобы после долгой паузы не пытаться догонять сотни шагов)
+    const qint64 nowNs = frameClock.nsecsElapsed();
+    frameStartNs = nowNs;
+    double frameTime = (nowNs - lastFrameNs) / 1e9;
+    lastFrameNs = nowNs;
+    if (frameTime > MAX_FRAME_TIME) frameTime = MAX_FRAME_TIME;
+    physicsAccumulator += frameTime;
+
+    // Физические шаги фиксированной длины — исход удара не зависит от частоты кадров
+    const double step = GameLogic::PHYSICS_STEP;
+    while (physicsAccumulator >= step) {
+        logic.update(GameLogic::PHYSICS_STEP);
+        physicsAccumulator -= step;
+    }
+    renderAlpha = static_cast<float>(physicsAccumulator / step);
+
+    // Подсказка прицела: последний запрос мыши, не дольше бюджета кадра
+    if (aimAssist && dragging && aimPreview.advance(AIM_PREVIEW_BUDGET_MS)) {
+        damage += shownPreviewRect;
+        shownPreviewRect = aimPreviewRect();
+        damage += shownPreviewRect;
+    }
+    // Карта ударов дозаполняется по кусочку за кадр
+    if (heatmap.advance(HEATMAP_BUDGET_MS)) {
+        heatmapDirty = true;
+        damage += heatmapArea().toAlignedRect();
+        damage += analysisInfoRect();
+    }
 
     // Если шашки всё ещё двигаются — ждём
     if (logic.isMoving()) {
-        update();
+        finishFrame();
         return;
     }
 
+    // Шашки остановились после удара — начало следующего хода
+    if (shotInFlight) {
+        shotInFlight = false;
+        recordTurn();
+    }
+
     // Проверка конца игры
     static bool s_gameEndEmitted = false; // защита от повторного эмита события окончания игры
     if (logic.checkGameOver()) {
@@ -266,122 +441,307 @@ void GameWidget::onFrame()
                 s_gameEndEmitted = true;
             }
         }
+        finishFrame();
         return;
     } else {
         // Если игра снова активна (например, новая игра), сбрасываем флаг
         s_gameEndEmitted = false;
     }
 
-    // Ход бота если очередь за ним
-    if (!playerTurn) {
+    // Ход бота если очередь за ним (и поиск ещё не запущен)
+    if (!playerTurn && !bot.isThinking()) {
         makeBotMove();
     }
 
-    update();
+    finishFrame();
+}
+
+// Что изменилось с прошлой отрисовки: шашки (старое и новое место каждой
+// сдвинувшейся) и надписи интерфейса
+void GameWidget::collectDamage()
+{
+    const float radius = logic.checkerRadius();
+    const int count = logic.getCheckerCount();
+    for (int i = count; i < pieceRects.size(); ++i) damage += pieceRects[i]; // шашек стало меньше
+    pieceRects.resize(count);
+    for (int i = 0; i < count; ++i) {
+        QRect r;
+        if (logic.isCheckerAlive(i)) r = BoardRenderer::pieceRect(logic.renderPosition(i, renderAlpha), radius);
+        if (r == pieceRects[i]) continue;
+        damage += pieceRects[i];
+        damage += r;
+        pieceRects[i] = r;
+    }
+
+    const HudState hud = hudState();
+    if (hud.white != shownHud.white || hud.black != shownHud.black) damage += scoreRect();
+    if (hud.turn != shownHud.turn) damage += turnRect();
+    if (hud.canTakeBack != shownHud.canTakeBack) damage += undoButtonRect();
+    // Кольцо выделения переехало — перерисовываются прежние и новые шашки
+    if (hud.selected != shownHud.selected || hud.highlighted != shownHud.highlighted) {
+        for (int i : { shownHud.selected, shownHud.highlighted, hud.selected, hud.highlighted }) {
+            if (i >= 0 && i < count) damage += pieceRects[i];
+        }
+    }
+    shownHud = hud;
 }
 
-// makeBotMove оставляем как в вашей текущей реализации (вызов логики бота затем shoot + playerTurn = true)
+// Конец кадра: перерисовка накопленных областей и решение, нужен ли
+// следующий кадр. Без работы цикл засыпает (Idle); с работой, но без
+// перерисовки (или когда виджет скрыт либо окно свёрнуто и отрисовки не
+// будет) следующий onFrame приходит по таймеру, иначе — после отрисовки.
+void GameWidget::finishFrame()
+{
+    collectDamage();
+    const bool painting = !damage.isEmpty();
+    if (painting) {
+        if (showPaintTime) damage += paintTimeRect();
+        update(damage);
+        damage = QRegion();
+    }
+
+    if (!hasWork()) {
+        runState = RunState::Idle;
+        return;
+    }
+    const bool willPaint = painting && isVisible() && !window()->isMinimized();
+    if (!willPaint && !frameScheduled) {
+        frameScheduled = true;
+        QTimer::singleShot(QUIET_FRAME_MS, this, &GameWidget::onFrame);
+    }
+}
+
+GameWidget::HudState GameWidget::hudState() const
+{
+    HudState hud;
+    hud.white = logic.getWhiteCheckers().size();
+    hud.black = logic.getBlackCheckers().size();
+    hud.turn = playerTurn ? 0 : bot.isThinking() ? 1 : 2;
+    hud.canTakeBack = history.canUndo() || shotInFlight;
+    hud.selected = dragging ? selectedChecker : -1;
+    hud.highlighted = analysisMode && heatmap.isActive() ? heatmap.checker() : -1;
+    return hud;
+}
+
+// Линия прицеливания с наконечником (20 px) и толщиной пера
+QRect GameWidget::aimLineRect() const
+{
+    if (!dragging || !logic.isCheckerAlive(selectedChecker)) return QRect();
+    const QPointF from = logic.getCheckerPosition(selectedChecker);
+    return QRectF(from, currentMouse).normalized().toAlignedRect().adjusted(-24, -24, 24, 24);
+}
+
+// Траектории подсказки с контурами шашек на концах
+QRect GameWidget::aimPreviewRect() const
+{
+    const AimPreview::Outcome &o = aimPreview.result();
+    if (!o.valid) return QRect();
+
+    const int reach = qCeil(logic.checkerRadius()) + 4;
+    QRect bounds;
+    for (const QVector<QPointF> &path : o.paths) {
+        if (path.size() < 2) continue;
+        bounds |= QPolygonF(path).boundingRect().toAlignedRect().adjusted(-reach, -reach, reach, reach);
+    }
+    return bounds;
+}
+
+// Квадрат карты ударов вокруг выбранной шашки (пустой, если карты нет)
+QRectF GameWidget::heatmapArea() const
+{
+    if (!heatmap.isActive() || !logic.isCheckerAlive(heatmap.checker())) return QRectF();
+    const float outer = logic.checkerRadius() * 1.2f + 3.0f * logic.cellSize();
+    const QPointF center = logic.getCheckerPosition(heatmap.checker());
+    return QRectF(center.x() - outer, center.y() - outer, 2 * outer, 2 * outer);
+}
+
+// Запускает поиск хода бота в фоне; сам удар делает onBotMoveReady
 void GameWidget::makeBotMove()
 {
     if (playerTurn || logic.isMoving() || logic.checkGameOver()) return;
 
-    QVector<int> blackCheckers = logic.getBlackCheckers();
-    if (blackCheckers.isEmpty()) {
+    if (logic.getBlackCheckers().isEmpty()) {
         playerTurn = true;
         return;
     }
 
-    // Попытка получить ход от движка
-    BotMove bm = logic.findBestMove(Qt::black);
-    // скорость/мощность выстрела бота зависит от выбранной сложности:
-    float botSpeedMult = 1.0f;
-    switch (difficulty) {
-    case Easy:   botSpeedMult = 0.7f; break;
-    case Medium: botSpeedMult = 1.0f; break;
-    case Hard:   botSpeedMult = 1.35f; break;
-    default: break;
-    }
+    // Поток поиска получает копию партии — GUI продолжает рисовать кадры
+    bot.start(logic, Side::Black);
+}
+
+// Результат поиска приходит через очередь событий: сила уже с множителем
+// сложности, запасной ход BotPlayer выбрал сам (затем shoot + playerTurn = true)
+void GameWidget::onBotMoveReady(const BotMove &bm)
+{
+    if (playerTurn || logic.isMoving() || logic.checkGameOver()) return;
 
     if (bm.checkerIndex >= 0) {
-        QPointF scaledForce = bm.force * botSpeedMult;
-        logic.shoot(bm.checkerIndex, scaledForce);
-        playerTurn = true;
-        return;
+        logic.shoot(bm.checkerIndex, bm.force);
+        shotInFlight = true;
+        heatmap.clear(); // карта была для прежней позиции
+        update();
     }
+    playerTurn = true;
+    wake();
+}
 
-    // fallback (если findBestMove не дал результата)
-    QVector<int> whiteCheckers = logic.getWhiteCheckers();
+void GameWidget::keyPressEvent(QKeyEvent *e)
+{
+    if (e->matches(QKeySequence::Undo)) {
+        takeBack();
+    } else if (e->matches(QKeySequence::Redo)) {
+        redoTurn();
+    } else if (e->key() == Qt::Key_F3) {
+        showPaintTime = !showPaintTime;
+        update();
+    } else if (e->key() == Qt::Key_F4) {
+        toggleTrace();
+    } else if (e->key() == Qt::Key_H) {
+        analysisMode = !analysisMode;
+        dragging = false;
+        selectedChecker = -1;
+        aimPreview.clear();
+        if (!analysisMode) heatmap.clear();
+        update();
+    } else {
+        QWidget::keyPressEvent(e);
+    }
+}
 
-    float angleNoiseDeg = 18.0f;
-    float forceNoisePct = 0.25f;
-    int candidatesPerChecker = 3;
-    switch (difficulty) {
-    case Easy:   angleNoiseDeg = 40.0f; forceNoisePct = 0.5f;  candidatesPerChecker = 1; break;
-    case Medium: angleNoiseDeg = 18.0f; forceNoisePct = 0.25f; candidatesPerChecker = 3; break;
-    case Hard:   angleNoiseDeg = 6.0f;  forceNoisePct = 0.10f; candidatesPerChecker = 6; break;
-    default: break;
+// F4: запись трассировки; при выключении записанное сохраняется рядом с
+// журналом (chepaev-trace.json — открывается в ui.perfetto.dev)
+void GameWidget::toggleTrace()
+{
+    if (!Trace::isEnabled()) {
+        Trace::setEnabled(true);
+        logInfo(lcData) << "Запись трассировки включена";
+        return;
     }
+    Trace::setEnabled(false);
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(dir);
+    const QString path = dir + "/chepaev-trace.json";
+    if (Trace::exportJson(path)) logInfo(lcData) << "Трассировка сохранена:" << path;
+    else logWarning(lcData) << "Не удалось записать трассировку:" << path;
+}
 
-    struct Candidate { int checkerIndex; QPointF force; float score; };
-    QVector<Candidate> candidates;
-    candidates.reserve(blackCheckers.size() * candidatesPerChecker);
+void GameWidget::recordTurn()
+{
+    GameState state;
+    if (logic.saveState(state, playerTurn ? Side::White : Side::Black)) history.record(state);
+}
 
-    for (int bi : blackCheckers) {
-        if (!logic.isCheckerAlive(bi)) continue;
+// Назад к прошлому ходу игрока: его удар и ответ бота отменяются. Если бот
+// уже думает или шашки ещё катятся, текущий ход отменяется целиком.
+void GameWidget::takeBack()
+{
+    const GameState *state = nullptr;
+    if (shotInFlight || !playerTurn) {
+        // Позиция текущего хода ещё не записана или ход у бота — возвращаемся
+        // к последней записанной позиции игрока (текущей или раньше)
+        const GameState *current = history.current();
+        state = current && current->toMove == Side::White ? current : history.undoTo(Side::White);
+    } else {
+        state = history.undoTo(Side::White);
+    }
+    if (state) applyState(*state);
+}
 
-        QPointF startPos = logic.getCheckerPosition(bi);
+void GameWidget::redoTurn()
+{
+    if (shotInFlight || !playerTurn) return;
+    if (const GameState *state = history.redoTo(Side::White)) applyState(*state);
+}
 
-        QPointF bestTarget = startPos;
-        if (!whiteCheckers.isEmpty()) {
-            float bestD = 1e9f;
-            for (int wi : whiteCheckers) {
-                QPointF wp = logic.getCheckerPosition(wi);
-                float d = std::hypot(wp.x() - startPos.x(), wp.y() - startPos.y());
-                if (d < bestD) { bestD = d; bestTarget = wp; }
-            }
-        } else {
-            bestTarget = QPointF(startPos.x(), startPos.y() + 1.0f);
-        }
+void GameWidget::applyState(const GameState &state)
+{
+    bot.cancel();
+    logic.restoreState(state);
+    playerTurn = state.toMove == Side::White;
+    shotInFlight = false;
+    dragging = false;
+    selectedChecker = -1;
+    aimPreview.clear();
+    shownPreviewRect = QRect();
+    heatmap.clear();
+    physicsAccumulator = 0.0;
+    renderAlpha = 1.0f;
+    update();
+    wake();
+}
 
-        QPointF dir = bestTarget - startPos;
-        float len = std::hypot(dir.x(), dir.y());
-        if (len > 0.0f) dir /= len;
-        else dir = QPointF(0.0f, 1.0f);
-
-        for (int c = 0; c < candidatesPerChecker; ++c) {
-            float frac = (candidatesPerChecker > 1) ? (float)c / (candidatesPerChecker - 1) : 0.5f;
-            float angleOffset = (frac - 0.5f) * 2.0f * angleNoiseDeg;
-            float angleRad = angleOffset * (3.14159265f / 180.0f);
-            float cosA = std::cos(angleRad);
-            float sinA = std::sin(angleRad);
-            QPointF dirRot(dir.x()*cosA - dir.y()*sinA, dir.x()*sinA + dir.y()*cosA);
-
-            float baseForce = qBound(80.0f, len * 0.8f, 300.0f);
-            float rnd = static_cast<float>(QRandomGenerator::global()->generateDouble());
-            float forceMult = baseForce * (1.0f - forceNoisePct * rnd);
-            QPointF forceVec = dirRot * forceMult;
-
-            const float BOT_MAX_FORCE = 500.0f;
-            float fLen = std::hypot(forceVec.x(), forceVec.y());
-            if (fLen > BOT_MAX_FORCE) forceVec *= (BOT_MAX_FORCE / fLen);
-
-            float score = logic.evaluateMove(bi, forceVec);
-            candidates.append({ bi, forceVec, score });
+// Траектории удара из последнего готового предпросмотра: пунктир для каждой
+// сдвинутой шашки, контур на месте остановки, крест там, где шашка вылетит
+void GameWidget::drawAimPreview(QPainter &p) const
+{
+    const AimPreview::Outcome &o = aimPreview.result();
+    if (!o.valid || o.checker != selectedChecker) return;
+
+    const float radius = logic.checkerRadius();
+    p.save();
+    p.setBrush(Qt::NoBrush);
+    for (int i = 0; i < o.paths.size(); ++i) {
+        const QVector<QPointF> &path = o.paths[i];
+        if (path.size() < 2) continue;
+
+        const bool striker = i == o.checker;
+        const QColor color = striker ? QColor(255, 215, 0, 200) : QColor(135, 206, 250, 200);
+        p.setPen(QPen(color, 2, Qt::DashLine, Qt::RoundCap));
+        p.drawPolyline(path.constData(), path.size());
+
+        const QPointF endPos = path.last();
+        if (o.start.isAlive(i) && !o.end.isAlive(i)) {
+            p.setPen(QPen(QColor(231, 76, 60, 230), 3, Qt::SolidLine, Qt::RoundCap));
+            const float d = radius * 0.5f;
+            p.drawLine(endPos + QPointF(-d, -d), endPos + QPointF(d, d));
+            p.drawLine(endPos + QPointF(-d, d), endPos + QPointF(d, -d));
+        } else {
+            p.setPen(QPen(color, 2, Qt::DotLine));
+            p.drawEllipse(endPos, radius, radius);
         }
     }
+    p.restore();
+}
 
-    if (candidates.isEmpty()) {
-        playerTurn = true;
-        return;
+void GameWidget::startHeatmap(int checker)
+{
+    if (checker < 0) {
+        heatmap.clear();
+    } else {
+        heatmap.start(logic.snapshot(), checker, PLAYER_MIN_FORCE, PLAYER_MAX_FORCE);
     }
+    heatmapImage = QImage();
+    heatmapDirty = true;
+    update();
+    wake();
+}
 
-    std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b){
-        return a.score > b.score;
-    });
+// Карта вокруг выбранной шашки: картинка перестраивается, только когда
+// advance дозаполнил клетки, а в остальных кадрах просто рисуется готовая
+void GameWidget::drawHeatmap(QPainter &p)
+{
+    const QRectF area = heatmapArea();
+    if (!area.isEmpty()) {
+        if (heatmapDirty) {
+            heatmapImage = BoardRenderer::heatmapImage(heatmap, logic.checkerRadius() * 1.2f, area.width() / 2);
+            heatmapDirty = false;
+        }
+        p.save();
+        p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+        p.drawImage(area, heatmapImage);
+        p.restore();
+    }
 
-    Candidate best = candidates.first();
-    // увеличиваем/уменьшаем силу в соответствии с выбранной сложностью
-    QPointF finalForce = best.force * botSpeedMult;
-    logic.shoot(best.checkerIndex, finalForce);
-    playerTurn = true;
+    QString text = QString::fromUtf8("Анализ (H — выход): щёлкните по шашке");
+    if (heatmap.isActive()) {
+        text = QString::fromUtf8("Анализ: %1 ударов%2  · зелёный — выигрыш, красный — потеря")
+                   .arg(heatmap.samples())
+                   .arg(heatmap.isComplete() ? QString() : QString::fromUtf8("…"));
+    }
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(0, 0, 0, 160));
+    p.drawRoundedRect(analysisInfoRect(), 8, 8);
+    p.setPen(Qt::white);
+    p.setFont(QFont("Arial", 11, QFont::Bold));
+    p.drawText(analysisInfoRect(), Qt::AlignCenter, text);
 }
@@ -2,9 +2,16 @@
 #define GAMEWIDGET_H
 
 #include <QWidget>
-#include <QTimer>
+#include <QElapsedTimer>
 #include <QPixmap>
+#include <QRegion>
 #include "gamelogic.h"
+#include "aimpreview.h"
+#include "shotheatmap.h"
+#include "boardrenderer.h"
+#include "botworker.h"
+
+class QPainter;
 
 class GameWidget : public QWidget
 {
@@ -14,9 +21,11 @@ public:
     explicit GameWidget(QWidget *parent = nullptr);
     QSize sizeHint() const override;
 
-    enum Difficulty { Easy = 0, Medium = 1, Hard = 2 };
+    enum Difficulty { Easy = 0, Medium = 1, Hard = 2, Master = 3 };
     void setBotDifficulty(Difficulty d); // синхронизирует с GameLogic
     Difficulty botDifficulty() const { return difficulty; }
+    // Подсказка прицела: траектории удара по полной физике
+    void setAimAssist(bool on);
 
 signals:
     void gameEnded(const QString &winner);
@@ -25,6 +34,7 @@ signals:
 private slots:
     void onFrame();
     void makeBotMove();
+    void onBotMoveReady(const BotMove &bm);
 
 protected:
     void paintEvent(QPaintEvent *) override;
@@ -32,12 +42,41 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
 
 private:
     GameLogic logic;
-    QTimer gameTimer;
+    BoardRenderer renderer;
+    BotWorker bot; // поиск хода бота вне GUI-потока
+    GameHistory history; // позиции на начало ходов: отмена и повтор
+    AimPreview aimPreview;
+    bool aimAssist;
+
+    // Режим анализа (клавиша H): клик по шашке строит карту её ударов
+    ShotHeatmap heatmap;
+    bool analysisMode;
+    QImage heatmapImage;
+    bool heatmapDirty;
+
+    // Фиксированный шаг физики: реальное время копится в аккумуляторе и
+    // расходуется целыми шагами, остаток идёт на интерполяцию при отрисовке
+    static constexpr double MAX_FRAME_TIME = 0.25;  // ограничение от "спирали смерти"
+    static constexpr float AIM_PREVIEW_BUDGET_MS = 2.0f; // расчёт подсказки прицела за кадр
+    static constexpr float HEATMAP_BUDGET_MS = 4.0f;     // расчёт карты ударов за кадр
+    QElapsedTimer frameClock; // монотонные часы
+    qint64 lastFrameNs;
+    qint64 frameStartNs; // начало последнего onFrame: кадры не чаще FRAME_INTERVAL_NS
+    double physicsAccumulator;
+    float renderAlpha;
+    bool frameScheduled;
+    // Цикл кадров: Running — кадры идут (шашки катятся, считается подсказка
+    // или карта ударов, ход пора передать боту); Idle — цикл стоит и ничего
+    // не считает, пока его не разбудят удар, готовый ход бота, ввод или смена размера
+    enum class RunState { Idle, Running };
+    RunState runState;
     bool dragging;
     bool playerTurn;
+    bool shotInFlight; // удар сделан, позиция ещё не записана в историю
     int selectedChecker;
     QPointF dragStart;
     QPointF currentMouse;
@@ -47,7 +86,58 @@ private:
 
     QPixmap bgPixmap; // фон для игры (тот же, что в меню)
 
+    // Замер отрисовки (F3 — показать)
+    double paintMsAverage;
+    bool showPaintTime;
+
+    // Частичная перерисовка: запоминается то, что нарисовано, и в кадре
+    // перерисовываются только изменившиеся области
+    struct HudState {
+        int white = -1;
+        int black = -1;
+        int turn = -1; // 0 — ход игрока, 1 — бот думает, 2 — ход бота
+        bool canTakeBack = false;
+        int selected = -1;    // шашки с кольцом
+        int highlighted = -1;
+    };
+    static constexpr int QUIET_FRAME_MS = 16; // кадр без перерисовки — по таймеру
+    static constexpr qint64 FRAME_INTERVAL_NS = QUIET_FRAME_MS * 1000000LL; // не чаще ~60 кадров/с
+    static constexpr qint64 STALLED_FRAME_NS = 4 * QUIET_FRAME_MS * 1000000LL; // цикл стоял
+    QVector<QRect> pieceRects; // след каждой шашки (пустой — выбита)
+    HudState shownHud;
+    QRect shownPreviewRect;
+    QRegion damage;            // накоплено за кадр
+
     void updateBoardGeometry();
+    void scheduleFrame();
+    void wake();
+    bool hasWork() const;
+    HudState hudState() const;
+    void collectDamage();
+    void finishFrame();
+    void toggleTrace(); // F4: запись трассировки
+
+    // История: запись позиции после остановки шашек, отмена своего хода
+    // вместе с ответом бота и повтор
+    void recordTurn();
+    void takeBack();
+    void redoTurn();
+    void applyState(const GameState &state);
+
+    void drawAimPreview(QPainter &p) const;
+    void startHeatmap(int checker);
+    void drawHeatmap(QPainter &p);
+
+    // Области интерфейса (они же — области перерисовки)
+    QRect menuButtonRect() const { return QRect(width() - 140, 12, 128, 40); }
+    QRect undoButtonRect() const { return QRect(width() - 140, 60, 128, 40); }
+    QRect scoreRect() const { return QRect(10, 10, 220, 72); }
+    QRect turnRect() const { return QRect(width() / 2 - 160, height() - 70, 320, 44); }
+    QRect paintTimeRect() const { return QRect(10, 88, 220, 20); }
+    QRect analysisInfoRect() const { return QRect(width() / 2 - 260, 12, 520, 32); }
+    QRect aimLineRect() const;
+    QRect aimPreviewRect() const;
+    QRectF heatmapArea() const;
 };
 
 #endif // GAMEWIDGET_H
@@ -1,13 +1,33 @@
 #include <QApplication>
+#include <QDir>
+#include <QStandardPaths>
 #include "mainwindow.h"
+#include "logger.h"
+#include "trace.h"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    // Журнал пишется фоновым потоком в каталог данных приложения
+    const QString logDir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(logDir);
+    Logger::start(logDir + "/chepaev.log");
+
+    // CHEPAEV_TRACE=файл — трассировка с запуска, JSON Chrome trace при выходе
+    // (в игре запись включает и выключает F4)
+    const QString tracePath = qEnvironmentVariable("CHEPAEV_TRACE");
+    Trace::setThreadName("GUI");
+    if (!tracePath.isEmpty()) Trace::setEnabled(true);
+
     MainWindow w;
     // Показываем сразу в полноэкранном режиме
     w.showFullScreen();
 
-    return a.exec();
+    const int code = a.exec();
+    if (!tracePath.isEmpty() && !Trace::exportJson(tracePath)) {
+        logWarning(lcData) << "Не удалось записать трассировку:" << tracePath;
+    }
+    Logger::stop();
+    return code;
 }
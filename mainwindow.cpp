@@ -23,6 +23,7 @@ MainWindow::MainWindow(QWidget *parent)
     btnResetStats(nullptr),
     btnExit(nullptr),
     difficultyCombo(nullptr),
+    aimAssistCheck(nullptr),
     statsLabel(nullptr)
 {
     setWindowTitle(QString::fromUtf8("Чепаев"));
@@ -147,9 +148,15 @@ void MainWindow::createMenuPage()
     difficultyCombo->addItem(QString::fromUtf8("Легко"));
     difficultyCombo->addItem(QString::fromUtf8("Средне"));
     difficultyCombo->addItem(QString::fromUtf8("Сложно"));
+    difficultyCombo->addItem(QString::fromUtf8("Мастер"));
     difficultyCombo->setCurrentIndex(1); // по умолчанию Medium
     contentLayout->addWidget(difficultyCombo);
 
+    // Подсказка прицела (по умолчанию выключена — это облегчение игры)
+    aimAssistCheck = new QCheckBox(QString::fromUtf8("Показывать траекторию удара"), contentContainer);
+    aimAssistCheck->setStyleSheet("QCheckBox { color: white; font-size: 14px; }");
+    contentLayout->addWidget(aimAssistCheck);
+
     // Большие стильные кнопки
     auto makeButton = [&](const QString &text)->QPushButton* {
         QPushButton *b = new QPushButton(text, contentContainer);
@@ -209,10 +216,13 @@ void MainWindow::startNewGame()
         case 0: gamePage->setBotDifficulty(GameWidget::Easy); break;
         case 1: gamePage->setBotDifficulty(GameWidget::Medium); break;
         case 2: gamePage->setBotDifficulty(GameWidget::Hard); break;
+        case 3: gamePage->setBotDifficulty(GameWidget::Master); break;
         default: gamePage->setBotDifficulty(GameWidget::Medium); break;
         }
     }
 
+    if (aimAssistCheck) gamePage->setAimAssist(aimAssistCheck->isChecked());
+
     stack->addWidget(gamePage);
     stack->setCurrentWidget(gamePage);
 
@@ -6,6 +6,7 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QComboBox>
+#include <QCheckBox>
 
 class GameWidget;
 
@@ -37,6 +38,7 @@ private:
     QPushButton *btnExit;
 
     QComboBox *difficultyCombo; // селектор сложности бота
+    QCheckBox *aimAssistCheck;  // подсказка траектории при прицеливании
     QLabel *statsLabel;         // отображаемая статистика в меню
 
     void createMenuPage();
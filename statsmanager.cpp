@@ -1,5 +1,5 @@
 #include "statsmanager.h"
-#include <QDebug>
+#include "logger.h"
 
 StatsManager::StatsManager(QObject *parent)
     : QObject(parent),
@@ -71,13 +71,9 @@ void StatsManager::addGameResult(const QString &winner)
 
     save();
 
-    qDebug() << "Статистика обновлена:";
-    qDebug() << "Всего игр:" << m_totalGames;
-    qDebug() << "Побед белых:" << m_whiteWins;
-    qDebug() << "Побед черных:" << m_blackWins;
-    qDebug() << "Ничьих:" << m_draws;
-    qDebug() << "Текущая серия побед:" << m_currentWinStreak << "Последний победитель:" << m_lastWinner;
-    qDebug() << "Максимальная серия побед:" << m_longestWinStreak;
+    logInfo(lcData) << "Статистика обновлена: игр" << m_totalGames
+                    << "побед белых" << m_whiteWins << "побед черных" << m_blackWins << "ничьих" << m_draws
+                    << "серия" << m_currentWinStreak << m_lastWinner << "лучшая серия" << m_longestWinStreak;
 }
 
 void StatsManager::reset()
@@ -0,0 +1,249 @@
+// Турнир двух ботов без отрисовки.
+//
+// tournament [--games N] [--threads T] [--seed S] [--max-shots M]
+//            [--openings K] [--book FILE] [--eval FILE] A B
+//
+// A и B — "easy", "medium", "hard" или "master", к любому можно добавить
+// ":<мс на ход>" (иначе время хода — по уровню, GameLogic::botLimits).
+// Партии идут параллельно на пуле рабочих (по партии на рабочего), бот
+// внутри партии считает в один поток. Первые K ударов партии (по умолчанию 2)
+// случайные, из зерна: без этого детерминированные боты играли бы одну и ту же
+// партию. Партии парные — одно и то же начало разыгрывается дважды со сменой
+// цветов. Партия длится не больше M ударов (по умолчанию 100), дальше — по
+// материалу. В отчёте: победы/ничьи/поражения, доля очков и разница Elo с 95%
+// интервалом, среднее время хода и скорость розыгрыша ударов.
+//
+// --eval FILE — веса обученной оценки (см. trainer) для поиска бота A;
+// бот B остаётся с материальной оценкой. Так master:N против master:N
+// сравнивает оценки при равном времени.
+
+#include "botplayer.h"
+#include "evaluator.h"
+#include "gamelogic.h"
+#include "openingbook.h"
+#include "workpool.h"
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
+#include <QVector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Options {
+    int games = 200;
+    int threads = 0;
+    quint32 seed = 1;
+    int maxShots = 100;
+    int openingShots = 2;
+    QString bookPath;
+    QString evalPath;
+    BotConfig a;
+    BotConfig b;
+};
+
+struct GameRecord {
+    int scoreA2;          // очки A, удвоенные: 2 — победа, 1 — ничья, 0 — поражение
+    int shots;
+    qint64 physicsNs;     // пошаговая физика игры
+    qint64 thinkNs[2];    // A, B
+    int moves[2];
+    qint64 searchShots[2];
+};
+
+// Пошаговая физика игры до остановки
+void playShot(GameLogic &game, const BotMove &move)
+{
+    if (move.checkerIndex < 0) return;
+    game.shoot(move.checkerIndex, move.force);
+    int steps = 0;
+    do { game.update(GameLogic::PHYSICS_STEP); } while (game.isMoving() && ++steps < 10000);
+}
+
+// Случайный удар для начала партии: своя шашка в сторону ближайшего врага с разбросом
+BotMove randomOpeningShot(const GameLogic &game, Side side, QRandomGenerator &rng)
+{
+    const QVector<int> own = game.getCheckersOf(side);
+    const QVector<int> enemy = game.getCheckersOf(opponentOf(side));
+    if (own.isEmpty() || enemy.isEmpty()) return {-1, QPointF(0, 0), 0.0f};
+
+    const int checker = own[rng.bounded(int(own.size()))];
+    const QPointF from = game.getCheckerPosition(checker);
+    QPointF target = game.getCheckerPosition(enemy.first());
+    for (int e : enemy) {
+        const QPointF d = game.getCheckerPosition(e) - from;
+        const QPointF best = target - from;
+        if (d.x() * d.x() + d.y() * d.y() < best.x() * best.x() + best.y() * best.y()) {
+            target = game.getCheckerPosition(e);
+        }
+    }
+    const double angle = std::atan2(target.y() - from.y(), target.x() - from.x())
+                         + (rng.generateDouble() - 0.5) * 40.0 * 3.14159265 / 180.0;
+    const double power = 120.0 + rng.bounded(300.0);
+    return {checker, QPointF(std::cos(angle) * power, std::sin(angle) * power), 0.0f};
+}
+
+GameRecord playGame(const Options &opt, int game, const OpeningBook *book,
+                    const PositionEvaluator *evaluatorA)
+{
+    const quint32 pairSeed = opt.seed * 1000003u + quint32(game / 2);
+    QRandomGenerator openingRng(pairSeed);
+
+    BotConfig ca = opt.a;
+    BotConfig cb = opt.b;
+    ca.threads = cb.threads = 1; // параллельность — по партиям
+    BotPlayer players[2] = { BotPlayer(ca, pairSeed * 2 + 1), BotPlayer(cb, pairSeed * 2 + 2) };
+    players[0].setOpeningBook(book);
+    players[1].setOpeningBook(book);
+    players[0].setEvaluator(evaluatorA);
+
+    const bool aIsWhite = (game % 2 == 0);
+    GameLogic logic;
+    logic.initBoard();
+
+    GameRecord rec = {};
+    Side toMove = Side::White;
+    QElapsedTimer timer;
+    for (int shot = 0; shot < opt.maxShots; ++shot) {
+        if (logic.aliveCount(Side::White) == 0 || logic.aliveCount(Side::Black) == 0) break;
+
+        const int who = ((toMove == Side::White) == aIsWhite) ? 0 : 1;
+        const BotMove move = shot < opt.openingShots
+                                 ? randomOpeningShot(logic, toMove, openingRng)
+                                 : players[who].chooseMove(logic, toMove);
+        timer.start();
+        playShot(logic, move);
+        rec.physicsNs += timer.nsecsElapsed();
+        rec.shots++;
+        toMove = opponentOf(toMove);
+    }
+
+    const Side sideA = aIsWhite ? Side::White : Side::Black;
+    const int own = logic.aliveCount(sideA);
+    const int enemy = logic.aliveCount(opponentOf(sideA));
+    rec.scoreA2 = own > enemy ? 2 : own < enemy ? 0 : 1;
+    for (int p = 0; p < 2; ++p) {
+        rec.thinkNs[p] = players[p].thinkNs();
+        rec.moves[p] = players[p].moves();
+        rec.searchShots[p] = players[p].searchShots();
+    }
+    return rec;
+}
+
+double eloFromScore(double p)
+{
+    p = qBound(0.0005, p, 0.9995);
+    return -400.0 * std::log10(1.0 / p - 1.0);
+}
+
+bool parseArgs(int argc, char *argv[], Options &opt)
+{
+    QVector<QString> bots;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue) opt.games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) opt.seed = quint32(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--max-shots") == 0 && hasValue) opt.maxShots = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--openings") == 0 && hasValue) opt.openingShots = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--book") == 0 && hasValue) opt.bookPath = QString::fromLocal8Bit(argv[++i]);
+        else if (std::strcmp(argv[i], "--eval") == 0 && hasValue) opt.evalPath = QString::fromLocal8Bit(argv[++i]);
+        else if (argv[i][0] == '-') return false;
+        else bots.push_back(QString::fromLocal8Bit(argv[i]));
+    }
+    return bots.size() == 2 && opt.games > 0 && opt.maxShots > 0
+           && BotConfig::parse(bots[0], opt.a) && BotConfig::parse(bots[1], opt.b);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: tournament [--games N] [--threads T] [--seed S] [--max-shots M]\n"
+                             "                  [--openings K] [--book FILE] [--eval FILE] A B\n"
+                             "bots: easy, medium, hard, master, optionally with :<ms per move>\n");
+        return 2;
+    }
+
+    // Отладочный вывод логики на тысячах партий только мешает
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    OpeningBook book;
+    if (!opt.bookPath.isEmpty() && !book.open(opt.bookPath)) {
+        std::fprintf(stderr, "cannot open book %s\n", qPrintable(opt.bookPath));
+        return 1;
+    }
+
+    LearnedEvaluator evaluator;
+    if (!opt.evalPath.isEmpty() && !evaluator.load(opt.evalPath)) {
+        std::fprintf(stderr, "cannot load evaluator weights %s\n", qPrintable(opt.evalPath));
+        return 1;
+    }
+
+    WorkPool pool(opt.threads);
+    QVector<GameRecord> records(opt.games);
+    GameRecord *out = records.data();
+    const OpeningBook *bookPtr = book.isOpen() ? &book : nullptr;
+    const PositionEvaluator *evaluatorPtr = evaluator.isLoaded() ? &evaluator : nullptr;
+
+    QElapsedTimer wall;
+    wall.start();
+    pool.parallelFor(opt.games, 1, [&](int begin, int end, int) {
+        for (int g = begin; g < end; ++g) out[g] = playGame(opt, g, bookPtr, evaluatorPtr);
+    });
+    const double seconds = wall.nsecsElapsed() / 1e9;
+
+    int wins = 0, draws = 0, losses = 0;
+    long long shots = 0;
+    qint64 physicsNs = 0;
+    qint64 thinkNs[2] = {0, 0};
+    long long moves[2] = {0, 0};
+    long long searchShots[2] = {0, 0};
+    double sum = 0.0, sumSq = 0.0;
+    for (const GameRecord &r : records) {
+        if (r.scoreA2 == 2) wins++;
+        else if (r.scoreA2 == 1) draws++;
+        else losses++;
+        const double s = r.scoreA2 / 2.0;
+        sum += s;
+        sumSq += s * s;
+        shots += r.shots;
+        physicsNs += r.physicsNs;
+        for (int p = 0; p < 2; ++p) {
+            thinkNs[p] += r.thinkNs[p];
+            moves[p] += r.moves[p];
+            searchShots[p] += r.searchShots[p];
+        }
+    }
+
+    // Доля очков и её стандартная ошибка по исходам партий
+    const double n = opt.games;
+    const double p = sum / n;
+    const double variance = qMax(0.0, sumSq / n - p * p);
+    const double se = std::sqrt(variance / n);
+    const double lo = p - 1.96 * se;
+    const double hi = p + 1.96 * se;
+
+    const QString nameA = opt.a.name() + (evaluatorPtr ? "+eval" : "");
+    const QString nameB = opt.b.name();
+    std::printf("%s vs %s: %d games on %d threads, %.1f s (%.1f games/s)\n",
+                qPrintable(nameA), qPrintable(nameB), opt.games, pool.workerCount(), seconds, n / seconds);
+    std::printf("%s: +%d =%d -%d (win %.1f%%, draw %.1f%%, loss %.1f%%)\n", qPrintable(nameA),
+                wins, draws, losses, 100.0 * wins / n, 100.0 * draws / n, 100.0 * losses / n);
+    std::printf("score %.1f%% (95%% CI %.1f..%.1f%%), Elo %+.0f (95%% CI %+.0f..%+.0f)\n",
+                100 * p, 100 * qMax(0.0, lo), 100 * qMin(1.0, hi),
+                eloFromScore(p), eloFromScore(lo), eloFromScore(hi));
+    for (int b = 0; b < 2; ++b) {
+        std::printf("%-12s think %.3f ms/move, search %.0f shots/s\n", qPrintable(b == 0 ? nameA : nameB),
+                    thinkNs[b] / 1e6 / qMax(1LL, moves[b]),
+                    thinkNs[b] > 0 ? searchShots[b] / (thinkNs[b] / 1e9) : 0.0);
+    }
+    std::printf("game physics: %lld shots, %.0f shots/s per thread\n",
+                shots, physicsNs > 0 ? shots / (physicsNs / 1e9) : 0.0);
+    return 0;
+}
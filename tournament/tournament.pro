@@ -0,0 +1,11 @@
+# Турнир ботов без окна: партии параллельно на всех ядрах, отчёт с Elo
+QT = core
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = tournament
+
+include(../core/core.pri)
+
+SOURCES += \
+    tournament.cpp
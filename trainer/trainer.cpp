@@ -0,0 +1,376 @@
+// Обучение оценки позиции для поиска бота (листья MCTS, кандидаты AnytimeBot).
+//
+// trainer [--games N] [--threads T] [--seed S] [--model linear|mlp]
+//         [--epochs E] [--move-ms MS] [--out FILE]
+//
+// 1. Партии ботов Medium и Hard друг с другом по MS мс на ход (по умолчанию 2,
+//    чтобы тысячи партий укладывались в минуты; пары уровней и цвета из зерна,
+//    первые 2-4 удара случайные, не больше 100 ударов, дальше — по материалу)
+//    идут параллельно на пуле рабочих. После каждого удара позиция
+//    записывается с точки зрения обеих сторон: признаки EvalFeatures и
+//    итог партии для этой стороны (1 / 0.5 / 0).
+// 2. Партии делятся на обучающие и проверочные (каждая десятая). На обучающих
+//    считаются среднее и разброс признаков, модель (логистическая регрессия
+//    или MLP 16-16-1) учится Adam по кросс-энтропии.
+// 3. Выводятся log-loss и точность на решённых партиях у модели и у
+//    MaterialEvaluator, веса пишутся в файл (по умолчанию evaluator.weights)
+//    и проверяются загрузкой в LearnedEvaluator.
+
+#include "botplayer.h"
+#include "evaluator.h"
+#include "gamelogic.h"
+#include "workpool.h"
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace {
+
+const int F = LearnedEvaluator::FEATURES;
+const int H = LearnedEvaluator::HIDDEN;
+
+struct Options {
+    int games = 2000;
+    int threads = 0;
+    quint32 seed = 1;
+    LearnedEvaluator::ModelType model = LearnedEvaluator::Mlp;
+    int epochs = 40;
+    float moveMs = 2.0f;
+    QString out = "evaluator.weights";
+};
+
+struct Sample {
+    float x[F];
+    float material;  // оценка MaterialEvaluator для сравнения
+    float target;    // итог партии для стороны, с точки зрения которой признаки
+};
+
+void playShot(GameLogic &game, const BotMove &move)
+{
+    if (move.checkerIndex < 0) return;
+    game.shoot(move.checkerIndex, move.force);
+    int steps = 0;
+    do { game.update(GameLogic::PHYSICS_STEP); } while (game.isMoving() && ++steps < 10000);
+}
+
+// Случайный удар: своя шашка в сторону ближайшего врага с разбросом
+BotMove randomShot(const GameLogic &game, Side side, QRandomGenerator &rng)
+{
+    const QVector<int> own = game.getCheckersOf(side);
+    const QVector<int> enemy = game.getCheckersOf(opponentOf(side));
+    if (own.isEmpty() || enemy.isEmpty()) return {-1, QPointF(0, 0), 0.0f};
+
+    const int checker = own[rng.bounded(int(own.size()))];
+    const QPointF from = game.getCheckerPosition(checker);
+    QPointF target = game.getCheckerPosition(enemy.first());
+    for (int e : enemy) {
+        const QPointF d = game.getCheckerPosition(e) - from;
+        const QPointF best = target - from;
+        if (d.x() * d.x() + d.y() * d.y() < best.x() * best.x() + best.y() * best.y()) {
+            target = game.getCheckerPosition(e);
+        }
+    }
+    const double angle = std::atan2(target.y() - from.y(), target.x() - from.x())
+                         + (rng.generateDouble() - 0.5) * 40.0 * 3.14159265 / 180.0;
+    const double power = 120.0 + rng.bounded(300.0);
+    return {checker, QPointF(std::cos(angle) * power, std::sin(angle) * power), 0.0f};
+}
+
+std::vector<Sample> recordGame(const Options &opt, int game)
+{
+    const int MAX_SHOTS = 100;
+    const quint32 gameSeed = opt.seed * 1000003u + quint32(game);
+    QRandomGenerator rng(gameSeed);
+
+    BotConfig configs[2];
+    for (BotConfig &c : configs) {
+        c.difficulty = rng.bounded(2) ? Hard : Medium;
+        c.budgetMs = opt.moveMs;
+        c.threads = 1; // параллельность — по партиям
+        c.useBook = false;
+    }
+    BotPlayer players[2] = { BotPlayer(configs[0], gameSeed * 2 + 1), BotPlayer(configs[1], gameSeed * 2 + 2) };
+    const int openingShots = 2 + rng.bounded(3);
+
+    GameLogic logic;
+    logic.initBoard();
+    const MaterialEvaluator material;
+    std::vector<Sample> samples;
+    std::vector<Side> perspectives;
+
+    Side toMove = Side::White;
+    for (int shot = 0; shot < MAX_SHOTS; ++shot) {
+        if (logic.aliveCount(Side::White) == 0 || logic.aliveCount(Side::Black) == 0) break;
+        const BotMove move = shot < openingShots
+                                 ? randomShot(logic, toMove, rng)
+                                 : players[int(toMove)].chooseMove(logic, toMove);
+        playShot(logic, move);
+        toMove = opponentOf(toMove);
+
+        const CheckerStore &pieces = logic.checkerStore();
+        const BoardGeometry g = logic.geometry();
+        if (PositionEvaluator::terminalValue(pieces, Side::White) >= 0.0f) break;
+        for (Side p : { Side::White, Side::Black }) {
+            Sample s;
+            EvalFeatures::extract(pieces, g, p, toMove, s.x);
+            s.material = material.evaluate(pieces, g, p, toMove);
+            s.target = 0.0f;
+            samples.push_back(s);
+            perspectives.push_back(p);
+        }
+    }
+
+    const int white = logic.aliveCount(Side::White);
+    const int black = logic.aliveCount(Side::Black);
+    const float whiteScore = white > black ? 1.0f : white < black ? 0.0f : 0.5f;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i].target = perspectives[i] == Side::White ? whiteScore : 1.0f - whiteScore;
+    }
+    return samples;
+}
+
+// Параметры при обучении: нормализованные входы, плоский массив для Adam
+struct Model {
+    LearnedEvaluator::ModelType type;
+    std::vector<float> params; // W1[H][F], b1[H], w2[H], b2 (у линейной — w[F], b)
+
+    int rows() const { return type == LearnedEvaluator::Linear ? 1 : H; }
+    float *w1() { return params.data(); }
+    float *b1() { return params.data() + rows() * F; }
+    float *w2() { return b1() + rows(); }
+    float *b2() { return w2() + H; }
+
+    explicit Model(LearnedEvaluator::ModelType t, QRandomGenerator &rng)
+        : type(t), params(size_t(rows() * F + rows() + H + 1), 0.0f)
+    {
+        if (type == LearnedEvaluator::Linear) return;
+        const float scale = std::sqrt(2.0f / F);
+        for (int k = 0; k < H * F; ++k) w1()[k] = float(rng.generateDouble() * 2.0 - 1.0) * scale;
+        for (int j = 0; j < H; ++j) w2()[j] = float(rng.generateDouble() * 2.0 - 1.0) * 0.5f;
+    }
+
+    // Выход сети; при grad != nullptr добавляет градиент кросс-энтропии
+    float forward(const float *x, float target, float *grad)
+    {
+        if (type == LearnedEvaluator::Linear) {
+            float z = b1()[0];
+            for (int i = 0; i < F; ++i) z += w1()[i] * x[i];
+            const float p = 1.0f / (1.0f + std::exp(-z));
+            if (grad) {
+                const float dz = p - target;
+                for (int i = 0; i < F; ++i) grad[i] += dz * x[i];
+                grad[F] += dz;
+            }
+            return p;
+        }
+
+        float hidden[H];
+        float z = *b2();
+        for (int j = 0; j < H; ++j) {
+            float a = b1()[j];
+            for (int i = 0; i < F; ++i) a += w1()[j * F + i] * x[i];
+            hidden[j] = qMax(0.0f, a);
+            z += w2()[j] * hidden[j];
+        }
+        const float p = 1.0f / (1.0f + std::exp(-z));
+        if (grad) {
+            const float dz = p - target;
+            float *gw1 = grad;
+            float *gb1 = grad + H * F;
+            float *gw2 = gb1 + H;
+            float *gb2 = gw2 + H;
+            for (int j = 0; j < H; ++j) {
+                gw2[j] += dz * hidden[j];
+                if (hidden[j] <= 0.0f) continue;
+                const float dh = dz * w2()[j];
+                for (int i = 0; i < F; ++i) gw1[j * F + i] += dh * x[i];
+                gb1[j] += dh;
+            }
+            *gb2 += dz;
+        }
+        return p;
+    }
+};
+
+struct Metrics {
+    double logLoss;
+    double accuracy; // по решённым партиям
+};
+
+Metrics measure(const std::vector<Sample> &data, const std::function<float(const Sample &)> &predict)
+{
+    double loss = 0.0;
+    int decisive = 0;
+    int correct = 0;
+    for (const Sample &s : data) {
+        const double p = qBound(1e-4, double(predict(s)), 1.0 - 1e-4);
+        loss -= s.target * std::log(p) + (1.0 - s.target) * std::log(1.0 - p);
+        if (s.target != 0.5f) {
+            decisive++;
+            if ((p > 0.5) == (s.target > 0.5f)) correct++;
+        }
+    }
+    return { data.empty() ? 0.0 : loss / data.size(), decisive ? double(correct) / decisive : 0.0 };
+}
+
+bool parseArgs(int argc, char *argv[], Options &opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue) opt.games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) opt.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) opt.seed = quint32(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--epochs") == 0 && hasValue) opt.epochs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--move-ms") == 0 && hasValue) opt.moveMs = float(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--out") == 0 && hasValue) opt.out = QString::fromLocal8Bit(argv[++i]);
+        else if (std::strcmp(argv[i], "--model") == 0 && hasValue) {
+            const char *m = argv[++i];
+            if (std::strcmp(m, "linear") == 0) opt.model = LearnedEvaluator::Linear;
+            else if (std::strcmp(m, "mlp") == 0) opt.model = LearnedEvaluator::Mlp;
+            else return false;
+        } else return false;
+    }
+    return opt.games >= 10 && opt.epochs > 0 && opt.moveMs > 0.0f;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: trainer [--games N>=10] [--threads T] [--seed S]\n"
+                             "               [--model linear|mlp] [--epochs E] [--move-ms MS] [--out FILE]\n");
+        return 2;
+    }
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    // 1. Партии
+    WorkPool pool(opt.threads);
+    std::vector<std::vector<Sample>> games(opt.games);
+    QElapsedTimer timer;
+    timer.start();
+    pool.parallelFor(opt.games, 1, [&](int begin, int end, int) {
+        for (int g = begin; g < end; ++g) games[g] = recordGame(opt, g);
+    });
+
+    std::vector<Sample> train;
+    std::vector<Sample> validation;
+    for (int g = 0; g < opt.games; ++g) {
+        std::vector<Sample> &dst = (g % 10 == 9) ? validation : train;
+        dst.insert(dst.end(), games[g].begin(), games[g].end());
+    }
+    std::printf("self-play: %d games, %zu train / %zu validation positions, %.1f s\n",
+                opt.games, train.size(), validation.size(), timer.nsecsElapsed() / 1e9);
+    if (train.empty()) return 1;
+
+    // 2. Нормализация и обучение
+    LearnedEvaluator::Weights weights;
+    weights.type = opt.model;
+    for (int i = 0; i < F; ++i) {
+        double sum = 0.0, sumSq = 0.0;
+        for (const Sample &s : train) { sum += s.x[i]; sumSq += double(s.x[i]) * s.x[i]; }
+        const double mean = sum / train.size();
+        weights.mean[i] = float(mean);
+        weights.stddev[i] = float(std::sqrt(qMax(0.0, sumSq / train.size() - mean * mean)));
+    }
+    auto normalized = [&weights](const Sample &s, float *x) {
+        for (int i = 0; i < F; ++i) {
+            x[i] = weights.stddev[i] > 1e-6f ? (s.x[i] - weights.mean[i]) / weights.stddev[i] : 0.0f;
+        }
+    };
+
+    QRandomGenerator rng(opt.seed);
+    Model model(opt.model, rng);
+    const size_t P = model.params.size();
+    std::vector<float> grad(P), m(P, 0.0f), v(P, 0.0f);
+    const int BATCH = 256;
+    const float LR = opt.model == LearnedEvaluator::Linear ? 0.01f : 0.003f;
+    const float L2 = 1e-5f;
+    const float BETA1 = 0.9f, BETA2 = 0.999f, EPS = 1e-8f;
+    std::vector<int> order(train.size());
+    for (size_t k = 0; k < order.size(); ++k) order[k] = int(k);
+
+    auto predict = [&](const Sample &s) {
+        float x[F];
+        normalized(s, x);
+        return model.forward(x, s.target, nullptr);
+    };
+
+    timer.start();
+    int step = 0;
+    for (int epoch = 0; epoch < opt.epochs; ++epoch) {
+        for (size_t k = order.size(); k > 1; --k) std::swap(order[k - 1], order[rng.bounded(int(k))]);
+        for (size_t base = 0; base < order.size(); base += BATCH) {
+            const size_t end = qMin(order.size(), base + BATCH);
+            std::fill(grad.begin(), grad.end(), 0.0f);
+            for (size_t k = base; k < end; ++k) {
+                float x[F];
+                normalized(train[order[k]], x);
+                model.forward(x, train[order[k]].target, grad.data());
+            }
+            step++;
+            const float inv = 1.0f / float(end - base);
+            const float c1 = 1.0f - std::pow(BETA1, float(step));
+            const float c2 = 1.0f - std::pow(BETA2, float(step));
+            for (size_t k = 0; k < P; ++k) {
+                const float g = grad[k] * inv + L2 * model.params[k];
+                m[k] = BETA1 * m[k] + (1.0f - BETA1) * g;
+                v[k] = BETA2 * v[k] + (1.0f - BETA2) * g * g;
+                model.params[k] -= LR * (m[k] / c1) / (std::sqrt(v[k] / c2) + EPS);
+            }
+        }
+        if ((epoch + 1) % 10 == 0 || epoch + 1 == opt.epochs) {
+            const Metrics t = measure(train, predict);
+            const Metrics val = measure(validation, predict);
+            std::printf("epoch %3d: train log-loss %.4f, validation log-loss %.4f, accuracy %.1f%%\n",
+                        epoch + 1, t.logLoss, val.logLoss, 100.0 * val.accuracy);
+        }
+    }
+    std::printf("training: %.1f s\n", timer.nsecsElapsed() / 1e9);
+
+    // 3. Сравнение, запись и проверка файла
+    const Metrics learned = measure(validation, predict);
+    const Metrics baseline = measure(validation, [](const Sample &s) { return s.material; });
+    std::printf("validation %-9s log-loss %.4f, accuracy %.1f%%\n", "model", learned.logLoss, 100.0 * learned.accuracy);
+    std::printf("validation %-9s log-loss %.4f, accuracy %.1f%%\n", "material", baseline.logLoss, 100.0 * baseline.accuracy);
+
+    for (int j = 0; j < model.rows(); ++j) {
+        for (int i = 0; i < F; ++i) weights.w1[j][i] = model.w1()[j * F + i];
+        weights.b1[j] = model.b1()[j];
+    }
+    if (opt.model == LearnedEvaluator::Mlp) {
+        for (int j = 0; j < H; ++j) weights.w2[j] = model.w2()[j];
+        weights.b2 = *model.b2();
+    }
+    if (!LearnedEvaluator::save(opt.out, weights)) {
+        std::fprintf(stderr, "cannot write %s\n", qPrintable(opt.out));
+        return 1;
+    }
+
+    LearnedEvaluator check;
+    if (!check.load(opt.out)) {
+        std::fprintf(stderr, "cannot reload %s\n", qPrintable(opt.out));
+        return 1;
+    }
+    std::vector<float> raw(validation.size() * F);
+    std::vector<float> out(validation.size());
+    for (size_t k = 0; k < validation.size(); ++k) {
+        std::memcpy(raw.data() + k * F, validation[k].x, sizeof(validation[k].x));
+    }
+    check.evaluateBatch(raw.data(), int(validation.size()), out.data());
+    float maxDiff = 0.0f;
+    for (size_t k = 0; k < validation.size(); ++k) {
+        maxDiff = qMax(maxDiff, std::fabs(out[k] - predict(validation[k])));
+    }
+    std::printf("wrote %s, reload max |diff| %.2e\n", qPrintable(opt.out), double(maxDiff));
+    return maxDiff < 1e-3f ? 0 : 1;
+}
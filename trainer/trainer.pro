@@ -0,0 +1,11 @@
+# Обучение оценки позиции по партиям бота с самим собой (консольная утилита, только QtCore)
+QT = core
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = trainer
+
+include(../core/core.pri)
+
+SOURCES += \
+    trainer.cpp
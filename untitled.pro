@@ -4,17 +4,22 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+# Приложение собирается из chepaev.pro: там ядро стоит в зависимостях
+include(core/core.pri)
+
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
     gamewidget.cpp \
-    gamelogic.cpp \
+    boardrenderer.cpp \
+    botworker.cpp \
     statsmanager.cpp
 
 HEADERS += \
     mainwindow.h \
     gamewidget.h \
-    gamelogic.h \
+    boardrenderer.h \
+    botworker.h \
     statsmanager.h
 
 RESOURCES += \